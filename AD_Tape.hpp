@@ -0,0 +1,87 @@
+/**
+ * @file AD_Tape.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ * 
+ * @brief An AD_Tape class that evaluates a Polynomial and its gradient together
+ * by reverse-mode automatic differentiation
+ */
+
+#pragma once
+#include <vector>
+#include "Polynomial.hpp"
+
+using namespace std;
+
+/**
+ * @brief A class for the reverse-mode automatic differentiation tape of a polynomial
+ * @details The tape is recorded once from the sparse terms of a Polynomial. Each sweep
+ * reuses the same buffers, so evaluating f(x) and its gradient does not allocate:
+ * - forward sweep: for each factor x_i^e of each term, store x_i^e, e*x_i^(e-1) and the
+ * product of the coefficient and the factors before it, then add up the terms
+ * - backward sweep: go over the factors of each term in reverse, multiplying the running product
+ * of the factors after it, which gives the adjoint of the factor, then apply the chain rule
+ * 
+ * Both sweeps visit each factor once, thus the cost is a small constant multiple of eval_f
+ * @tparam T The scalar type, explicitly instantiated for float, double and long double
+ */
+template <typename T>
+class AD_Tape
+{
+public:
+    // ======================================================================
+    // Constructor of AD_Tape
+    // ======================================================================
+
+    /**
+     * @brief Construct a new AD_Tape object by recording the tape of the given polynomial
+     * @param poly The polynomial to record
+     */
+    AD_Tape(const Polynomial<T> &);
+
+    // ======================================================================
+    // Public member functions of AD_Tape: evaluate functions
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to evaluate f(x_1, x_2, ...) and its gradient
+     * with one forward sweep and one backward sweep over the tape
+     * @param x_vars_efg A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @param gradient_efg A vector of scalars of type T of size num_of_x_vars, overwritten with the gradient
+     * @return T The resulting value of f(x_1, x_2, ...)
+     * @throws err_invalid_x_vector if the given vectors and the polynomial have different numbers of x variables
+     */
+    T eval_f_gradient(const vector<T> &, vector<T> &);
+
+    /**
+     * @brief Public member function used to evaluate f(x_1, x_2, ...) with the forward sweep only,
+     * f is computed exactly as by eval_f_gradient, and the gradient at the same x values
+     * can be obtained afterwards by gradient_of_last_sweep
+     * @param x_vars_ef A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @return T The resulting value of f(x_1, x_2, ...)
+     * @throws err_invalid_x_vector if the given vector and the polynomial have different numbers of x variables
+     */
+    T eval_f(const vector<T> &);
+
+    /**
+     * @brief Public member function used to evaluate the gradient with the backward sweep
+     * at the x values of the last forward sweep (the last call of eval_f or eval_f_gradient)
+     * @param gradient_gls A vector of scalars of type T of size num_of_x_vars, overwritten with the gradient
+     * @throws err_invalid_x_vector if the given vector and the polynomial have different numbers of x variables
+     */
+    void gradient_of_last_sweep(vector<T> &) const;
+
+private:
+    // ======================================================================
+    // Private data of AD_Tape
+    // ======================================================================
+
+    size_t num_of_x_vars;  // number of x variables in the polynomial function
+    Sparse_Terms<T> terms; // the recorded terms of the polynomial
+
+    vector<T> factor_values;   // x_i^e of each factor, stored by the forward sweep
+    vector<T> factor_partials; // e*x_i^(e-1) of each factor, stored by the forward sweep
+    vector<T> prefix_products; // coefficient * the factors before each factor in its term
+};
@@ -0,0 +1,93 @@
+#include <vector>
+#include <algorithm>
+#include "AD_Tape.hpp"
+#include "Polynomial.hpp"
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+// ======================================================================
+// Constructor of AD_Tape
+// ======================================================================
+// see AD_Tape.hpp for description
+
+template <typename T>
+AD_Tape<T>::AD_Tape(const Polynomial<T> &poly)
+    : num_of_x_vars(poly.get_num_of_x_vars()), terms(poly.get_terms()),
+      factor_values(terms.x_idx.size()), factor_partials(terms.x_idx.size()),
+      prefix_products(terms.x_idx.size())
+{
+}
+
+// ======================================================================
+// Public member functions of AD_Tape: evaluate functions
+// ======================================================================
+// see AD_Tape.hpp for description
+
+template <typename T>
+T AD_Tape<T>::eval_f_gradient(const vector<T> &x_vars_efg, vector<T> &gradient_efg)
+{
+    if (gradient_efg.size() != num_of_x_vars)
+        throw err_invalid_x_vector();
+    T result_value{eval_f(x_vars_efg)};
+    gradient_of_last_sweep(gradient_efg);
+    return result_value;
+}
+
+template <typename T>
+T AD_Tape<T>::eval_f(const vector<T> &x_vars_ef)
+{
+    if (x_vars_ef.size() != num_of_x_vars)
+        throw err_invalid_x_vector();
+    size_t num_of_terms_ef{terms.coeffs.size()};
+
+    // forward sweep
+    T result_value{0};
+    for (size_t term_idx_ef{0}; term_idx_ef < num_of_terms_ef; term_idx_ef++)
+    {
+        T running_product{terms.coeffs[term_idx_ef]};
+        for (size_t factor_idx_ef{terms.offsets[term_idx_ef]};
+             factor_idx_ef < terms.offsets[term_idx_ef + 1]; factor_idx_ef++)
+        {
+            T x_ef{x_vars_ef[terms.x_idx[factor_idx_ef]]};
+            unsigned int exp_ef{terms.exps[factor_idx_ef]};
+            T pow_minus_1{int_pow(x_ef, exp_ef - 1)}; // exponents are positive
+            prefix_products[factor_idx_ef] = running_product;
+            factor_values[factor_idx_ef] = pow_minus_1 * x_ef;
+            factor_partials[factor_idx_ef] = exp_ef * pow_minus_1;
+            running_product *= factor_values[factor_idx_ef];
+        }
+        result_value += running_product;
+    }
+    return result_value;
+}
+
+template <typename T>
+void AD_Tape<T>::gradient_of_last_sweep(vector<T> &gradient_gls) const
+{
+    if (gradient_gls.size() != num_of_x_vars)
+        throw err_invalid_x_vector();
+    size_t num_of_terms_gls{terms.coeffs.size()};
+
+    // backward sweep, the adjoint of each term is 1 since f = term_0 + term_1 + ...
+    fill(gradient_gls.begin(), gradient_gls.end(), T{0});
+    for (size_t term_idx_gls{0}; term_idx_gls < num_of_terms_gls; term_idx_gls++)
+    {
+        T suffix_product{1}; // product of the factors after the current factor
+        for (size_t factor_idx_gls{terms.offsets[term_idx_gls + 1]};
+             factor_idx_gls-- > terms.offsets[term_idx_gls];)
+        {
+            T factor_adjoint{prefix_products[factor_idx_gls] * suffix_product};
+            gradient_gls[terms.x_idx[factor_idx_gls]] += factor_adjoint * factor_partials[factor_idx_gls];
+            suffix_product *= factor_values[factor_idx_gls];
+        }
+    }
+}
+
+// ======================================================================
+// Explicit instantiations of AD_Tape
+// ======================================================================
+
+template class AD_Tape<float>;
+template class AD_Tape<double>;
+template class AD_Tape<long double>;
@@ -0,0 +1,48 @@
+/**
+ * @file Algorithm_Options.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief The names of the optimization algorithms and an Algorithm_Options struct for their parameters
+ *
+ * @details The names are used by Result_Handling, Input_Data::run_algorithm and the command line options
+ * to select an algorithm. Algorithm_Options stores the parameters of the algorithms that are not part of
+ * input_function.txt, they are set on Input_Data with set_algorithm_options
+ */
+
+#pragma once
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// the names of all optimization algorithms of Input_Data
+const vector<string> algorithm_names{"gradient_descent", "newtons_method", "lbfgs", "bfgs", "conjugate_gradient",
+                                     "trust_region", "levenberg_marquardt", "shamanskii",
+                                     "barzilai_borwein", "nesterov", "adam"};
+
+/**
+ * @brief Function used to check whether a string is the name of an optimization algorithm
+ * @param algorithm_str The string to check
+ * @return true if algorithm_str is one of algorithm_names
+ */
+inline bool is_algorithm_name(const string &algorithm_str)
+{
+    return find(algorithm_names.begin(), algorithm_names.end(), algorithm_str) != algorithm_names.end();
+}
+
+/**
+ * @brief A struct for the parameters of the optimization algorithms
+ */
+struct Algorithm_Options
+{
+    size_t lbfgs_memory{8};           // number of (s, y) pairs stored by lbfgs
+    string bfgs_reset{"none"};        // how bfgs resets the inverse hessian when y * s <= 0: "none", "identity" or "hessian"
+    string cg_formula{"pr_plus"};     // beta of conjugate_gradient: "pr_plus" (Polak-Ribiere+) or "hager_zhang"
+    size_t refactor_interval{4};      // maximum number of iterations of shamanskii that use the same factorization
+    size_t nonmonotone_memory{10};    // number of recent values of f that barzilai_borwein improves on
+    long double learning_rate{0.001}; // fixed step size of nesterov and adam
+};
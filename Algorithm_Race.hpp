@@ -0,0 +1,171 @@
+/**
+ * @file Algorithm_Race.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief An Algorithm_Race class that races several optimization algorithms from the same initial point
+ *
+ * @details This library contains a class Algorithm_Race that takes an Input_Data and starts every
+ * candidate algorithm on its own thread from the initial_point of input_function.txt.
+ * The first algorithm that finds a stationary point (case 1) wins the race: it sets a stop flag
+ * shared by all candidates, and the other algorithms return case 5 at the start of their next iteration,
+ * or as soon as their current line search or trust region subproblem sees the flag
+ * (see Stop_Observer in Observer.hpp and stop_flag in Solver_Workspace.hpp).
+ * An algorithm that stops for another reason (case 2, 3, 4 or 6) does not stop the others. <br>
+ * The results file reports the winner and how long every candidate ran
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+#include "Algorithm_Options.hpp"
+#include "Input_Data.hpp"
+#include "Observer.hpp"
+#include "Solver_Workspace.hpp"
+#include "vector_overloads.hpp"
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+/**
+ * @brief A class for a race of optimization algorithms
+ * @tparam T The scalar type of the Input_Data
+ */
+template <typename T>
+class Algorithm_Race
+{
+public:
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Algorithm_Race object and run the race
+     * @param input An Input_Data class that stores the input data from input_function.txt, it is not modified
+     * @param input_algorithms The names of the candidate algorithms, each one runs on its own thread
+     * @throws err_unknown_algorithm if a candidate is not the name of an algorithm
+     */
+    Algorithm_Race(const Input_Data<T> &input, const vector<string> &input_algorithms)
+        : input_ar(input), algorithms(input_algorithms), runs(input_algorithms.size())
+    {
+        atomic<bool> stop_flag{false};
+        atomic<size_t> winner_idx{no_winner};
+        Polynomial<T> polyn_ar{input.get_polynomial()};
+
+        // the workspaces are created before any thread starts, so that every candidate starts at the same time
+        vector<Solver_Workspace<T>> workspaces;
+        workspaces.reserve(algorithms.size());
+        for (size_t alg_idx{0}; alg_idx < algorithms.size(); alg_idx++)
+        {
+            workspaces.emplace_back(polyn_ar);
+            workspaces.back().stop_flag = &stop_flag; // polled by the line searches and the trust region subproblem
+        }
+
+        chrono::time_point start_time{chrono::steady_clock::now()};
+        vector<future<void>> candidates;
+        for (size_t alg_idx{0}; alg_idx < algorithms.size(); alg_idx++)
+            candidates.push_back(async(launch::async, [&, alg_idx] {
+                Stop_Observer observer_ar(stop_flag);
+                Race_Run &run_ar{runs[alg_idx]};
+                run_ar.case_num = input_ar.run_algorithm(algorithms[alg_idx], input_ar.get_x_initial(), run_ar.x_final,
+                                                         workspaces[alg_idx], observer_ar);
+                run_ar.elapsed_time_seconds = chrono::steady_clock::now() - start_time;
+                if (run_ar.case_num == 1)
+                {
+                    // only the first candidate to converge becomes the winner
+                    size_t expected_idx{no_winner};
+                    if (winner_idx.compare_exchange_strong(expected_idx, alg_idx))
+                        stop_flag.store(true, memory_order_relaxed);
+                }
+            }));
+        // get() waits for each candidate and rethrows its exception, if any
+        for (future<void> &candidate : candidates)
+            candidate.get();
+        winner = winner_idx.load();
+    }
+
+    // ======================================================================
+    // Public member functions of Algorithm_Race: get and store results
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the name of the winner
+     * @return string The name of the first algorithm that found a stationary point, empty if none did
+     */
+    string get_winner() const
+    {
+        return (winner == no_winner) ? "" : algorithms[winner];
+    }
+
+    /**
+     * @brief Public member function used to store the results to a text file
+     * @param filename The name of the text file
+     * @throws err_fail_to_read_results_txt if the program fails to open the output file
+     */
+    void store_results(const string &filename) const
+    {
+        ofstream store_results{filename};
+        if (!store_results)
+            throw err_fail_to_read_results_txt();
+
+        store_results << "========== Algorithm Race Results =========="
+                      << "\n\n";
+        store_results << "min/max: " << input_ar.get_min_max() << '\n';
+        store_results << input_ar.get_polynomial() << '\n';
+        store_results << "initial_point: " << input_ar.get_x_initial();
+        store_results << "tolerance: " << input_ar.get_tolerance() << '\n';
+        store_results << "max_iter: " << input_ar.get_max_iter() << "\n\n";
+
+        if (winner == no_winner)
+            store_results << "No algorithm found a stationary point, see the case of each algorithm below" << "\n\n";
+        else
+            store_results << "Winner: " << algorithms[winner] << ", it took "
+                          << runs[winner].elapsed_time_seconds.count() << " seconds"
+                          << "\n\n";
+
+        for (size_t alg_idx{0}; alg_idx < algorithms.size(); alg_idx++)
+        {
+            const Race_Run &run_ar{runs[alg_idx]};
+            // to improve readability, round the values of the current x point to 3 decimal places
+            vector<T> x_round_3{run_ar.x_final};
+            for_each(x_round_3.begin(), x_round_3.end(),
+                     [](T &n) { n = round(n * 1000) / 1000; });
+            store_results << algorithms[alg_idx] << ": Case " << run_ar.case_num;
+            if (run_ar.case_num == 5)
+                store_results << " (stopped by the winner)";
+            store_results << ", ran for " << run_ar.elapsed_time_seconds.count() << " seconds" << '\n';
+            store_results << "   The current point is at: " << x_round_3;
+        }
+        store_results.close();
+    }
+
+private:
+    // ======================================================================
+    // Private data of Algorithm_Race
+    // ======================================================================
+
+    /**
+     * @brief A struct for the result of one candidate
+     */
+    struct Race_Run
+    {
+        vector<T> x_final;                                // the current x when the algorithm stopped
+        int case_num{0};                                  // the case returned by the algorithm, 5 if it lost the race
+        chrono::duration<double> elapsed_time_seconds{0}; // how long the algorithm ran
+    };
+
+    static constexpr size_t no_winner{static_cast<size_t>(-1)}; // no candidate found a stationary point
+
+    const Input_Data<T> &input_ar; // shared read-only by all candidates
+    vector<string> algorithms;     // the names of the candidates
+    vector<Race_Run> runs;         // one result per candidate, written only by its own thread
+    size_t winner{no_winner};      // index of the winner
+};
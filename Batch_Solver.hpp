@@ -0,0 +1,238 @@
+/**
+ * @file Batch_Solver.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A Batch_Solver class that solves many problems of a batch file in parallel
+ *
+ * @details This library contains a class Batch_Solver that reads a batch file of many problems,
+ * each problem is a record of 5 lines in the same format as input_function.txt. Records are separated
+ * by one or more empty lines, or by a line "---". <br>
+ * Every problem is a task of a Thread_Pool (see Thread_Pool.hpp): the task parses its record into an
+ * Input_Data and runs the algorithms (gradient_descent and newtons_method by default) from its initial point. A problem that is
+ * invalid does not stop the batch, its error message is reported instead. <br>
+ * All results are stored to one text file, with the case number (status code) and the runtime of
+ * every algorithm of every problem
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Algorithm_Options.hpp"
+#include "Input_Data.hpp"
+#include "Observer.hpp"
+#include "Solver_Workspace.hpp"
+#include "Thread_Pool.hpp"
+#include "vector_overloads.hpp"
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+/**
+ * @brief A class for solving a batch of problems
+ * @tparam T The scalar type of the problems
+ */
+template <typename T>
+class Batch_Solver
+{
+public:
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Batch_Solver object, read the batch file and solve every problem
+     * @param filename The name of the batch file
+     * @param input_algorithms The names of the algorithms performed on every problem
+     * @param input_algorithm_options The parameters of the algorithms, the same for every problem
+     * @param num_of_threads The number of worker threads, 0 uses the number of hardware threads
+     * @throws err_fail_to_read_batch_file if the program fails to open the batch file or it has no problem
+     */
+    Batch_Solver(const string &filename, const vector<string> &input_algorithms,
+                 const Algorithm_Options &input_algorithm_options, const size_t &num_of_threads)
+        : batch_filename(filename), algorithms(input_algorithms), algorithm_options(input_algorithm_options)
+    {
+        read_batch_file();
+
+        // time the batch
+        chrono::time_point start_time{chrono::steady_clock::now()};
+        Thread_Pool pool(num_of_threads);
+        num_of_threads_used = pool.get_num_of_threads();
+        for (size_t problem_idx{0}; problem_idx < problems.size(); problem_idx++)
+            pool.submit([this, problem_idx](size_t) { solve_problem(problems[problem_idx]); });
+        pool.wait();
+        chrono::time_point end_time{chrono::steady_clock::now()};
+        elapsed_time_seconds = end_time - start_time;
+    }
+
+    // ======================================================================
+    // Public member functions of Batch_Solver: store results
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to store the results of every problem to a text file
+     * @param filename The name of the text file
+     * @throws err_fail_to_read_results_txt if the program fails to open the output file
+     */
+    void store_results(const string &filename) const
+    {
+        ofstream store_results{filename};
+        if (!store_results)
+            throw err_fail_to_read_results_txt();
+
+        store_results << "========== Batch Results =========="
+                      << "\n\n";
+        store_results << "batch_file: " << batch_filename << '\n';
+        store_results << "problems: " << problems.size() << '\n';
+        store_results << "threads: " << num_of_threads_used << "\n\n";
+        store_results << "The batch took " << elapsed_time_seconds.count() << " seconds"
+                      << "\n\n";
+        store_results << "Case (status code): 1 stationary point found, 2 reached max_iter, "
+                      << "3 gradient norm too large, 4 singular hessian, 6 step no longer moves x, 0 invalid problem"
+                      << "\n\n";
+
+        for (size_t problem_idx{0}; problem_idx < problems.size(); problem_idx++)
+        {
+            const Batch_Problem &problem_bs{problems[problem_idx]};
+            store_results << "Problem " << problem_idx + 1 << " (line " << problem_bs.first_line_num << "): ";
+            if (!problem_bs.error_message.empty())
+            {
+                store_results << "Case 0" << '\n';
+                store_results << "   " << problem_bs.error_message << '\n';
+                continue;
+            }
+            store_results << problem_bs.polynomial_str << '\n';
+            for (size_t alg_idx{0}; alg_idx < algorithms.size(); alg_idx++)
+            {
+                const Batch_Run &run_bs{problem_bs.runs[alg_idx]};
+                // to improve readability, round the values of the current x point to 3 decimal places
+                vector<T> x_round_3{run_bs.x_final};
+                for_each(x_round_3.begin(), x_round_3.end(),
+                         [](T &n) { n = round(n * 1000) / 1000; });
+                store_results << "   " << algorithms[alg_idx] << ": Case " << run_bs.case_num << ", took "
+                              << run_bs.elapsed_time_seconds.count() << " seconds, the current point is at: "
+                              << x_round_3;
+            }
+        }
+        store_results.close();
+    }
+
+private:
+    // ======================================================================
+    // Private data of Batch_Solver
+    // ======================================================================
+
+    /**
+     * @brief A struct for the result of one algorithm on one problem
+     */
+    struct Batch_Run
+    {
+        vector<T> x_final;                                // the current x when the algorithm stopped
+        int case_num{0};                                  // the case returned by the algorithm
+        chrono::duration<double> elapsed_time_seconds{0}; // runtime of the algorithm
+    };
+
+    /**
+     * @brief A struct for one problem of the batch file, written only by the task solving it
+     */
+    struct Batch_Problem
+    {
+        vector<string> lines;       // the lines of the record
+        size_t first_line_num{0};   // line number of the first line of the record in the batch file
+        string polynomial_str{""};  // the polynomial, as stored by Polynomial
+        string error_message{""};   // the message of the exception thrown by an invalid problem
+        vector<Batch_Run> runs;     // one result per algorithm
+    };
+
+    string batch_filename;                            // the name of the batch file
+    vector<string> algorithms;                        // the names of the algorithms performed on every problem
+    Algorithm_Options algorithm_options;              // the parameters of the algorithms
+    vector<Batch_Problem> problems;                   // the problems of the batch file
+    size_t num_of_threads_used{0};                    // number of worker threads of the pool
+    chrono::duration<double> elapsed_time_seconds{0}; // wall time of the batch
+
+    // ======================================================================
+    // Private member functions of Batch_Solver: read and solve problems
+    // ======================================================================
+
+    /**
+     * @brief Private member function used to split the batch file into the records of the problems
+     * @throws err_fail_to_read_batch_file if the program fails to open the batch file or it has no problem
+     */
+    void read_batch_file()
+    {
+        ifstream batch_file{batch_filename};
+        if (!batch_file)
+            throw err_fail_to_read_batch_file();
+
+        string line_str{""};
+        size_t line_num{0};
+        Batch_Problem curr_problem;
+        while (getline(batch_file, line_str))
+        {
+            line_num++;
+            string trimmed_str{line_str};
+            trimmed_str.erase(remove_if(trimmed_str.begin(), trimmed_str.end(), ::isspace), trimmed_str.end());
+            if (trimmed_str.empty() or trimmed_str == "---")
+            {
+                // end of a record
+                if (!curr_problem.lines.empty())
+                    problems.push_back(move(curr_problem));
+                curr_problem = Batch_Problem{};
+                continue;
+            }
+            if (curr_problem.lines.empty())
+                curr_problem.first_line_num = line_num;
+            curr_problem.lines.push_back(line_str);
+        }
+        if (!curr_problem.lines.empty())
+            problems.push_back(move(curr_problem));
+        batch_file.close();
+
+        if (problems.empty())
+            throw err_fail_to_read_batch_file();
+    }
+
+    /**
+     * @brief Private member function used to parse a problem and perform every algorithm on it
+     * @param problem_bs The problem, its results are stored in it
+     */
+    void solve_problem(Batch_Problem &problem_bs) const
+    {
+        try
+        {
+            Input_Data<T> input_bs(problem_bs.lines);
+            input_bs.set_algorithm_options(algorithm_options);
+            stringstream polynomial_stream;
+            polynomial_stream << input_bs.get_polynomial();
+            problem_bs.polynomial_str = polynomial_stream.str();
+
+            // each problem has its own polynomial, thus its own workspace, reused by its algorithms
+            Solver_Workspace<T> workspace_bs(input_bs.get_polynomial());
+            Null_Observer observer_bs;
+            problem_bs.runs.resize(algorithms.size());
+            for (size_t alg_idx{0}; alg_idx < algorithms.size(); alg_idx++)
+            {
+                Batch_Run &run_bs{problem_bs.runs[alg_idx]};
+                chrono::time_point start_time{chrono::steady_clock::now()};
+                run_bs.case_num = input_bs.run_algorithm(algorithms[alg_idx], input_bs.get_x_initial(), run_bs.x_final,
+                                                         workspace_bs, observer_bs);
+                chrono::time_point end_time{chrono::steady_clock::now()};
+                run_bs.elapsed_time_seconds = end_time - start_time;
+            }
+        }
+        catch (const exception &e)
+        {
+            // an invalid problem is reported, the other problems are still solved
+            problem_bs.error_message = e.what();
+            replace(problem_bs.error_message.begin(), problem_bs.error_message.end(), '\n', ' ');
+        }
+    }
+};
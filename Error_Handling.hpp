@@ -41,7 +41,18 @@ class err_fail_to_read_iter_txt : public exception // derived from std::exceptio
 {
     const char *what() const throw()
     {
-        return "Error occurred when opening the output_iterations text file(s)";
+        return "Error occurred when opening the output_iterations file(s)";
+    }
+};
+
+/**
+ * @brief Exception to be thrown if a binary iteration trace cannot be read, see Iteration_Trace.hpp
+ */
+class err_invalid_trace_file : public exception // derived from std::exception
+{
+    const char *what() const throw()
+    {
+        return "Error occurred when reading the binary output_iterations file, it is missing or not a valid trace";
     }
 };
 
@@ -229,13 +240,68 @@ class err_invalid_x_vector : public exception // derived from std::exception
 };
 
 /**
- * @brief Exception to be thrown if the input algorithm string is not "gradient_descent" or "newtons_method"
+ * @brief Exception to be thrown if the input algorithm string is not the name of an algorithm (see Algorithm_Options.hpp)
  */
 class err_unknown_algorithm : public exception // derived from std::exception
 {
     const char *what() const throw()
     {
-        const char *message = "Unknown algorithm, Result_Handling only supports gradient_descent/newtons_method";
+        const char *message = "Unknown algorithm, Result_Handling only supports gradient_descent/newtons_method/lbfgs/bfgs/conjugate_gradient/trust_region/levenberg_marquardt/shamanskii/barzilai_borwein/nesterov/adam";
+        return message;
+    }
+};
+
+/**
+ * @brief Exception to be thrown if a command line option is unknown or has an invalid value
+ */
+class err_invalid_option : public exception // derived from std::exception
+{
+    const char *what() const throw()
+    {
+        const char *message = "Invalid command line option\n"
+                              "Options have the format key=value, for example: \"precision=double\"\n"
+                              "See README.md for the supported options";
+        return message;
+    }
+};
+
+/**
+ * @brief Exception to be thrown if the file of initial points of the multi-start mode
+ * cannot be opened, is empty or has a point that is not a valid x vector
+ */
+class err_invalid_starts_file : public exception // derived from std::exception
+{
+    const char *what() const throw()
+    {
+        const char *message = "Invalid starts_file\n"
+                              "Each non-empty line must have one initial point, with the same number of x values as the Polynomial,\n"
+                              "separated by ',', for example: \"1.5,-2,0.25\"";
+        return message;
+    }
+};
+
+/**
+ * @brief Exception to be thrown if the Sobol sequence is used with more x variables than it supports
+ */
+class err_sobol_too_many_dims : public exception // derived from std::exception
+{
+    const char *what() const throw()
+    {
+        const char *message = "sampling=sobol supports at most 21 x variables, use sampling=lhs or a starts_file instead";
+        return message;
+    }
+};
+
+/**
+ * @brief Exception to be thrown if the batch file cannot be opened or has no problem
+ */
+class err_fail_to_read_batch_file : public exception // derived from std::exception
+{
+    const char *what() const throw()
+    {
+        const char *message = "Error occurred when reading the batch file, it is missing or has no problem\n"
+                              "Each problem has the same 5 lines as input_function.txt,\n"
+                              "problems are separated by an empty line or a line \"---\"";
         return message;
     }
 };
@@ -13,12 +13,19 @@
 #include <string>
 #include <vector>
 #include "Polynomial.hpp"
+#include "Algorithm_Options.hpp"
+#include "Iteration_Trace.hpp"
+#include "Observer.hpp"
+#include "Solver_Workspace.hpp"
 
 using namespace std;
 
 /**
  * @brief A class for input data
+ * @tparam T The scalar type used for the polynomial, the x values and the tolerance,
+ * explicitly instantiated for float, double and long double
  */
+template <typename T>
 class Input_Data
 {
 public:
@@ -45,6 +52,17 @@ public:
      */
     Input_Data(const string &);
 
+    /**
+     * @brief Construct a new Input_Data::Input_Data object from the lines of a problem
+     * that are already in memory, for example a record of a batch file (see Batch_Solver.hpp)
+     * @param input_lines The 5 lines of the problem, in the same format as input_function.txt,
+     * empty lines after the fifth line are ignored
+     * @throws err_more_than_5_lines if there are more than 5 lines
+     * @throws err_less_than_5_lines if there are less than 5 lines
+     * @throws The same exceptions as Input_Data(const string &) if a line is invalid
+     */
+    Input_Data(const vector<string> &);
+
     // ======================================================================
     // Public member functions of Input_Data: get values
     // ======================================================================
@@ -59,32 +77,32 @@ public:
     /**
      * @brief Public member function used to obtain (but not modify) the Polynomial
      * stored in Input_data
-     * @return Polynomial Generated based on the polynomial string from input_function.txt
+     * @return Polynomial<T> Generated based on the polynomial string from input_function.txt
      */
-    Polynomial get_polynomial() const;
+    Polynomial<T> get_polynomial() const;
 
     /**
      * @brief Public member function used to obtain (but not modify) the x_initial
      * value stored in Input_data
-     * @return vector<long double> A vector of x values generated based on 
+     * @return vector<T> A vector of x values generated based on 
      * the initial_point from input_function.txt
      */
-    vector<long double> get_x_initial() const;
+    vector<T> get_x_initial() const;
 
     /**
      * @brief Public member function used to obtain (but not modify) the x_current
      * value stored in Input_data
-     * @return vector<long double> A vector of the current x values generated after
+     * @return vector<T> A vector of the current x values generated after
      * performing the optimization algorithms
      */
-    vector<long double> get_x_current() const;
+    vector<T> get_x_current() const;
 
     /**
      * @brief Public member function used to obtain (but not modify) the tolerance
      * value stored in Input_data
-     * @return long double Generated based on the tolerance from input_function.txt
+     * @return T Generated based on the tolerance from input_function.txt
      */
-    long double get_tolerance() const;
+    T get_tolerance() const;
 
     /**
      * @brief Public member function used to obtain (but not modify) the max_iter
@@ -93,6 +111,37 @@ public:
      */
     size_t get_max_iter() const;
 
+    /**
+     * @brief Public member function used to obtain (but not modify) the number of iteration records
+     * dropped by the last optimization algorithm because its trace writer fell behind
+     * @return size_t 0 unless the trace options drop records when the ring buffer is full
+     */
+    size_t get_dropped_trace_records() const;
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the parameters of the optimization algorithms
+     * @return Algorithm_Options The parameters of the optimization algorithms, see Algorithm_Options.hpp
+     */
+    Algorithm_Options get_algorithm_options() const;
+
+    // ======================================================================
+    // Public member functions of Input_Data: set options
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to set how the optimization algorithms store their iterations,
+     * see Iteration_Trace.hpp
+     * @param input_trace_options The format, stride, ring buffer size and full buffer policy of the traces
+     */
+    void set_trace_options(const Trace_Options &);
+
+    /**
+     * @brief Public member function used to set the parameters of the optimization algorithms,
+     * see Algorithm_Options.hpp
+     * @param input_algorithm_options The parameters of the optimization algorithms
+     */
+    void set_algorithm_options(const Algorithm_Options &);
+
     // ======================================================================
     // Public member functions of Input_Data: evaluate/perform algorithms
     // ======================================================================
@@ -104,35 +153,340 @@ public:
      * - Case # 1: the current x point is now updated to a stationary point <br>
      * - Case # 2: reached the given maximum number of iterations, 
      * the current x point is updated, but it might not be a stationary point <br>
-     * - Case # 3: the norm of current gradient is extremely large, algorithm is stopped to prevent overflow
+     * - Case # 3: the norm of current gradient is extremely large, algorithm is stopped to prevent overflow <br>
+     * - Case # 6: the step no longer moves the current x point, f cannot be improved at the precision of T
      * @details Gradient descent/ascent algorithm can be used to find either a local minimum or a local maximum,
-     * which is based on the input data that the user provided in input_function.txt
+     * which is based on the input data that the user provided in input_function.txt. <br>
+     * f(x) and the gradient of each iteration are evaluated together by an AD_Tape,
+     * all the vectors of the iterations are stored in a Solver_Workspace allocated before the first iteration. <br>
+     * The iterations are stored by an Iteration_Trace observer with the trace options
+     * (or not stored at all if the trace format is "none")
      */
     int gradient_descent();
 
+    /**
+     * @brief Public member function used to perform the gradient descent algorithm from the initial point,
+     * storing the iterations with the trace options like gradient_descent(), but without modifying Input_Data,
+     * so that different algorithms can be performed at the same time on different threads
+     * @param x_current_gd A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param dropped_gd Overwritten with the number of iteration records dropped by the trace
+     * @return int An integer that represents the case number, see gradient_descent()
+     */
+    int gradient_descent(vector<T> &, size_t &) const;
+
+    /**
+     * @brief Public member function used to perform the gradient descent algorithm based on Input_Data,
+     * calling the given observer with the state of each iteration (see Observer.hpp)
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param observer_gd The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent()
+     */
+    template <typename Observer>
+    int gradient_descent(Observer &);
+
+    /**
+     * @brief Public member function used to perform the gradient descent algorithm from the given start,
+     * without modifying Input_Data, so that several runs can be performed at the same time on different threads
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_gd A vector of scalars of type T that stores the initial x values
+     * @param x_current_gd A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_gd The buffers of the algorithm, created from the polynomial of Input_Data,
+     * each thread needs its own workspace
+     * @param observer_gd The observer of the iterations, an observer that can stop the algorithm
+     * (see Stop_Observer in Observer.hpp) is checked at the start of each iteration
+     * @return int An integer that represents the case number, see gradient_descent(), or
+     * - Case # 5: the observer requested the algorithm to stop, the current x is where it stopped
+     * @throws err_invalid_x_vector if the start and the polynomial have different numbers of x variables
+     */
+    template <typename Observer>
+    int gradient_descent(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
     /**
      * @brief Public member function used to perform the newton's method algorithm based on Input_Data,
      * @return int An integer that represents the case number <br> 
      * - Case # 1: the current x point is now updated to a stationary point <br>
      * - Case # 2: reached the given maximum number of iterations, 
      * the current x point is updated, but it might not be a stationary point <br>
-     * - Case # 3: the norm of current gradient is extremely large, algorithm is stopped to prevent overflow
-     * @details Due to the nature of the newton's method algorithm, it can only be used to find a stationary point
-     * near the initial point, that is, it cannot specifically find a local maximum or a local minimum
+     * - Case # 3: the norm of current gradient is extremely large, algorithm is stopped to prevent overflow <br>
+     * - Case # 4: the hessian of the current x point is singular, algorithm is stopped since
+     * the newton direction does not exist
+     * @details The newton direction is found by solving hessian * direction = -gradient with
+     * a Cholesky, LDL^T or LU factorization (see symmetric_factor in matrix.hpp) instead of 
+     * forming the inverse hessian. The gradient, hessian and factorization of the iterations are stored in
+     * a Solver_Workspace allocated before the first iteration. <br>
+     * Due to the nature of the newton's method algorithm, it can only be used to find a stationary point
+     * near the initial point, that is, it cannot specifically find a local maximum or a local minimum. <br>
+     * The iterations are stored by an Iteration_Trace observer with the trace options
+     * (or not stored at all if the trace format is "none")
      */
     int newtons_method();
 
+    /**
+     * @brief Public member function used to perform the newton's method algorithm from the initial point,
+     * storing the iterations with the trace options like newtons_method(), but without modifying Input_Data,
+     * so that different algorithms can be performed at the same time on different threads
+     * @param x_current_nm A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param dropped_nm Overwritten with the number of iteration records dropped by the trace
+     * @return int An integer that represents the case number, see newtons_method()
+     */
+    int newtons_method(vector<T> &, size_t &) const;
+
+    /**
+     * @brief Public member function used to perform the newton's method algorithm based on Input_Data,
+     * calling the given observer with the state of each iteration (see Observer.hpp)
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param observer_nm The observer of the iterations
+     * @return int An integer that represents the case number, see newtons_method()
+     */
+    template <typename Observer>
+    int newtons_method(Observer &);
+
+    /**
+     * @brief Public member function used to perform the newton's method algorithm from the given start,
+     * without modifying Input_Data, so that several runs can be performed at the same time on different threads
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_nm A vector of scalars of type T that stores the initial x values
+     * @param x_current_nm A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_nm The buffers of the algorithm, created from the polynomial of Input_Data,
+     * each thread needs its own workspace
+     * @param observer_nm The observer of the iterations, an observer that can stop the algorithm
+     * (see Stop_Observer in Observer.hpp) is checked at the start of each iteration
+     * @return int An integer that represents the case number, see newtons_method(), or
+     * - Case # 5: the observer requested the algorithm to stop, the current x is where it stopped
+     * @throws err_invalid_x_vector if the start and the polynomial have different numbers of x variables
+     */
+    template <typename Observer>
+    int newtons_method(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the L-BFGS algorithm from the given start,
+     * without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_lb A vector of scalars of type T that stores the initial x values
+     * @param x_current_lb A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_lb The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_lb The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details L-BFGS is a quasi-newton method: the direction is -H * gradient, where H approximates the
+     * inverse hessian from the last lbfgs_memory steps s = x_next - x and gradient changes y (see Algorithm_Options),
+     * applied with the two-loop recursion, so the hessian is never formed and the memory is O(lbfgs_memory * n). <br>
+     * The step size satisfies the strong wolfe conditions (see wolfe_line_search), thus y * s > 0 and H stays
+     * positive definite. Like gradient descent, it finds a local minimum or a local maximum based on min/max
+     */
+    template <typename Observer>
+    int lbfgs(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the BFGS algorithm from the given start,
+     * without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_bf A vector of scalars of type T that stores the initial x values
+     * @param x_current_bf A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_bf The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_bf The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details BFGS is a quasi-newton method: the direction is -H * gradient, where the n x n matrix H approximates
+     * the inverse hessian and is updated by a rank-two update after every step, in O(n^2) operations instead of
+     * the O(n^3) factorization of newton's method. The hessian itself is never evaluated, unless bfgs_reset is
+     * "hessian" (see Algorithm_Options). The step size satisfies the strong wolfe conditions (see wolfe_line_search).
+     * Like gradient descent, it finds a local minimum or a local maximum based on min/max
+     */
+    template <typename Observer>
+    int bfgs(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the nonlinear conjugate gradient algorithm from the given start,
+     * without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_cg A vector of scalars of type T that stores the initial x values
+     * @param x_current_cg A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_cg The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_cg The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details The direction is the gradient direction plus beta times the previous direction, with beta from
+     * the Polak-Ribiere+ or the Hager-Zhang formula (cg_formula, see Algorithm_Options), so the directions do not
+     * zig-zag like gradient descent and only O(n) memory is used. The algorithm restarts from the gradient direction
+     * every n iterations and whenever the direction does not improve f. The step size satisfies the strong wolfe
+     * conditions with c2 = 0.1 (see wolfe_line_search). Like gradient descent, it finds a local minimum or a
+     * local maximum based on min/max
+     */
+    template <typename Observer>
+    int conjugate_gradient(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the trust-region newton-cg algorithm from the given start,
+     * without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_tr A vector of scalars of type T that stores the initial x values
+     * @param x_current_tr A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_tr The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_tr The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details Every iteration minimizes the quadratic model of -max_or_min * f within a ball of radius
+     * trust_radius around the current x (see steihaug_solve), only with hessian-vector products, thus the hessian
+     * is never formed and the memory is O(n). The step is accepted if f improves by at least a tenth of the
+     * improvement predicted by the model, and the radius shrinks or grows with the agreement of the model and f.
+     * The algorithm returns case 6 if the radius shrinks below the precision of T relative to the norm of x.
+     * The step size of an iteration is 1 if its step is accepted and 0 otherwise. Unlike newton's method,
+     * it finds a local minimum or a local maximum based on min/max, and does not jump far from a poor initial point
+     */
+    template <typename Observer>
+    int trust_region(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the levenberg-marquardt (damped newton) algorithm
+     * from the given start, without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_lm A vector of scalars of type T that stores the initial x values
+     * @param x_current_lm A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_lm The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_lm The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), 4 if no damping makes
+     * the hessian positive definite (ex: the hessian is nan), or 5 if the observer requested the algorithm to stop
+     * @details The direction solves (H + damping * I) * direction = -gradient, where H is the hessian of
+     * -max_or_min * f, and the damping is the smallest tried value that makes H + damping * I positive definite,
+     * thus the direction always improves f, even at a singular or indefinite hessian. The damping decreases after
+     * a full step and increases otherwise, so the algorithm becomes newton's method near a local optimum and
+     * gradient descent far from it. The step size satisfies the strong wolfe conditions (see wolfe_line_search).
+     * Like gradient descent, it finds a local minimum or a local maximum based on min/max
+     */
+    template <typename Observer>
+    int levenberg_marquardt(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the shamanskii (modified newton) algorithm from the given start,
+     * without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_sh A vector of scalars of type T that stores the initial x values
+     * @param x_current_sh A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_sh The buffers of the algorithm, each thread needs its own workspace, its num_of_factorizations
+     * and num_of_skipped_factorizations are overwritten with the counts of the run
+     * @param observer_sh The observer of the iterations
+     * @return int An integer that represents the case number, see newtons_method(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details Like newton's method, every iteration takes the full step that solves hessian * direction = -gradient,
+     * but the factorization of the hessian is reused for refactor_interval iterations (see Algorithm_Options),
+     * since the hessian changes little near a stationary point. The hessian is evaluated and factored again
+     * earlier if a step with a reused factorization does not halve the gradient norm
+     */
+    template <typename Observer>
+    int shamanskii(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the barzilai-borwein (spectral gradient) algorithm
+     * from the given start, without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_bb A vector of scalars of type T that stores the initial x values
+     * @param x_current_bb A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_bb The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_bb The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details The direction is the gradient direction, like gradient descent, but the step size is the
+     * barzilai-borwein step s * s / s * y of the last step s and gradient change y, so most iterations need a
+     * single evaluation of f and the gradient. f may increase for some iterations: a step is accepted if f
+     * improves on the worst of the last nonmonotone_memory values of f (see Algorithm_Options), the nonmonotone
+     * line search of Grippo, Lampariello and Lucidi, otherwise the step size is reduced. If no step size is
+     * accepted, x is not moved and the search restarts from the gradient step of length 1, case 6 is returned
+     * if that fails as well, or if the step size becomes too small to move x.
+     * Like gradient descent, it finds a local minimum or a local maximum based on min/max
+     */
+    template <typename Observer>
+    int barzilai_borwein(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform nesterov's accelerated gradient algorithm
+     * from the given start, without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_na A vector of scalars of type T that stores the initial x values
+     * @param x_current_na A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_na The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_na The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details Each iteration takes a gradient step of the fixed learning_rate (see Algorithm_Options) and adds
+     * a growing multiple of the previous gradient step (momentum), without a line search, thus every iteration
+     * evaluates f and the gradient exactly once. The momentum is restarted when the gradient step goes
+     * against it (the adaptive restart of O'Donoghue and Candes).
+     * Like gradient descent, it finds a local minimum or a local maximum based on min/max
+     */
+    template <typename Observer>
+    int nesterov(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the adam algorithm from the given start, without modifying Input_Data
+     * @tparam Observer The type of the observer, for example Null_Observer or Iteration_Trace<T>
+     * @param x_start_ad A vector of scalars of type T that stores the initial x values
+     * @param x_current_ad A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_ad The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_ad The observer of the iterations
+     * @return int An integer that represents the case number, see gradient_descent(), or 5 if the observer
+     * requested the algorithm to stop
+     * @details Each x variable has its own step size: the step is the moving average of the gradient divided by
+     * the square root of the moving average of the squared gradient, times the fixed learning_rate
+     * (see Algorithm_Options), without a line search, thus every iteration evaluates f and the gradient exactly once.
+     * Like gradient descent, it finds a local minimum or a local maximum based on min/max
+     */
+    template <typename Observer>
+    int adam(const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the optimization algorithm with the given name from the given start,
+     * without modifying Input_Data, see the overloads of each algorithm that take a start
+     * @tparam Observer The type of the observer, for example Null_Observer or Stop_Observer
+     * @param algorithm_str A string representation of the optimization algorithm to perform
+     * @param x_start_ra A vector of scalars of type T that stores the initial x values
+     * @param x_current_ra A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param workspace_ra The buffers of the algorithm, each thread needs its own workspace
+     * @param observer_ra The observer of the iterations
+     * @return int An integer that represents the case number returned by the algorithm
+     * @throws err_unknown_algorithm if the algorithm string is not the name of an algorithm
+     */
+    template <typename Observer>
+    int run_algorithm(const string &, const vector<T> &, vector<T> &, Solver_Workspace<T> &, Observer &) const;
+
+    /**
+     * @brief Public member function used to perform the optimization algorithm with the given name from the
+     * initial point, storing the iterations with the trace options, without modifying Input_Data
+     * @param algorithm_str A string representation of the optimization algorithm to perform
+     * @param x_current_ra A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param dropped_ra Overwritten with the number of iteration records dropped by the trace
+     * @return int An integer that represents the case number returned by the algorithm
+     * @throws err_unknown_algorithm if the algorithm string is not the name of an algorithm
+     */
+    int run_algorithm(const string &, vector<T> &, size_t &) const;
+
+    /**
+     * @brief Public member function used to perform the optimization algorithm with the given name from the
+     * initial point with the given workspace, storing the iterations with the trace options, without modifying Input_Data
+     * @param algorithm_str A string representation of the optimization algorithm to perform
+     * @param x_current_ra A vector of scalars of type T, overwritten with the current x values when the algorithm stops
+     * @param dropped_ra Overwritten with the number of iteration records dropped by the trace
+     * @param workspace_ra The buffers of the algorithm, its counters (ex: num_of_factorizations) describe the run
+     * @return int An integer that represents the case number returned by the algorithm
+     * @throws err_unknown_algorithm if the algorithm string is not the name of an algorithm
+     */
+    int run_algorithm(const string &, vector<T> &, size_t &, Solver_Workspace<T> &) const;
+
 private:
     // ======================================================================
     // Private data of Input_Data
     // ======================================================================
 
-    int min_max{-1};                // default to minimize polynomial
-    Polynomial polyn;               // create a default Polynomial
-    vector<long double> x_initial;  // vector of the initial point, initialized to be empty
-    vector<long double> x_current;  // vector of the current point, initialized to be empty
-    long double tolerance{0.0001L}; // default tolerance
-    size_t max_iter{10000};         // default maximum number of iterations
+    int min_max{-1};        // default to minimize polynomial
+    Polynomial<T> polyn;    // create a default Polynomial
+    vector<T> x_initial;    // vector of the initial point, initialized to be empty
+    vector<T> x_current;    // vector of the current point, initialized to be empty
+    T tolerance{0.0001};    // default tolerance
+    size_t max_iter{10000}; // default maximum number of iterations
+
+    Trace_Options trace_options;         // default to store every iteration in binary format
+    Algorithm_Options algorithm_options; // default parameters of the algorithms
+    size_t dropped_trace_records{0}; // records dropped by the trace of the last algorithm
 
     string first_line_str{""};  // store min/max
     string second_line_str{""}; // store polynomial function in string
@@ -160,6 +514,15 @@ private:
      */
     void check_valid_file(const string &);
 
+    /**
+     * @brief Private member function used to check the number of lines of the input data,
+     * and then store each line privately in Input_Data
+     * @param lines_cvl The lines of the input data
+     * @throws err_more_than_5_lines if there are more than 5 lines
+     * @throws err_less_than_5_lines if there are less than 5 lines
+     */
+    void check_valid_lines(const vector<string> &);
+
     /**
      * @brief Private member function used to check the validity of 
      * the first line stored in Input_Data, if the first line is a valid min_max
@@ -211,19 +574,83 @@ private:
 
     /**
      * @brief Private member function used to evaluate the euclidean norm of a given vector
-     * @param vec_en A vector of long doubles that is used to get its euclidean norm
-     * @return long double The euclidean norm of the given vector 
+     * @param vec_en A vector of scalars of type T that is used to get its euclidean norm
+     * @return T The euclidean norm of the given vector 
      */
-    long double euclidean_norm(const vector<long double> &) const;
+    T euclidean_norm(const vector<T> &) const;
 
     /**
      * @brief Private member function used to perform the backtracking line search algorithm
-     * @param x_vec_bls A vector of long doubles that stores the current x values
-     * @param curr_gradient_bls A vector of long doubles that stores the current gradient vector
-     * @param directional_bls A vector of long doubles that stores the current directional vector
-     * @return long double An efficient step size for the gradient descent algorithm
-     */
-    long double backtracking_line_search(const vector<long double> &x_vec_bls,
-                                         const vector<long double> &curr_gradient_bls,
-                                         const vector<long double> &directional_bls) const;
-};
\ No newline at end of file
+     * @param x_vec_bls A vector of scalars of type T that stores the current x values
+     * @param f_x_bls The value of the polynomial at the current x values, evaluated by the tape of workspace_bls
+     * @param curr_gradient_bls A vector of scalars of type T that stores the current gradient vector
+     * @param directional_bls A vector of scalars of type T that stores the current directional vector
+     * @param workspace_bls The workspace whose tape evaluates f and the gradient, trial_x and trial_gradient
+     * are overwritten with the x values and the gradient at the returned step size
+     * @param f_trial_bls Overwritten with the value of the polynomial at the returned step size
+     * @return T An efficient step size for the gradient descent algorithm, if no step size moves x far enough to
+     * improve f, the first step size that no longer moves x (trial_x is then equal to x_vec_bls,
+     * and trial_gradient and f_trial_bls are not evaluated there)
+     * @details f at the trial x values is evaluated by the forward sweep of the tape, which computes f exactly
+     * as f_x_bls, so that the sufficient improvement condition compares values with the same rounding errors.
+     * Only the gradient at the returned step size is evaluated, by the backward sweep.
+     * The search ends early once the stop flag of workspace_bls is set
+     */
+    T backtracking_line_search(const vector<T> &x_vec_bls,
+                               const T &f_x_bls,
+                               const vector<T> &curr_gradient_bls,
+                               const vector<T> &directional_bls,
+                               Solver_Workspace<T> &workspace_bls,
+                               T &f_trial_bls) const;
+
+    /**
+     * @brief Private member function used to find a step size that satisfies the strong wolfe conditions
+     * on max_or_min * f, with a bracketing phase followed by a zoom phase (Nocedal and Wright, algorithms 3.5 and 3.6)
+     * @param x_vec_wls A vector of scalars of type T that stores the current x values
+     * @param f_x_wls The value of the polynomial at the current x values
+     * @param curr_gradient_wls A vector of scalars of type T that stores the current gradient vector
+     * @param directional_wls The search direction, it must be an ascent direction for a maximization
+     * and a descent direction for a minimization
+     * @param curvature_para The parameter c2 of the curvature condition, in the interval (0.0001, 1),
+     * 0.9 for quasi-newton methods and 0.1 for nonlinear conjugate gradient methods
+     * @param workspace_wls The workspace whose tape evaluates f and the gradient, trial_x and trial_gradient
+     * are overwritten with the x values and the gradient at the returned step size
+     * @param f_trial_wls Overwritten with the value of the polynomial at the returned step size
+     * @return T The step size. If the conditions are not met after 60 trials, the largest step size found that
+     * satisfies the sufficient decrease condition, or 0 if none does (trial_x and trial_gradient are then
+     * the current x values and gradient), the callers must not take a step of 0 again from the same x. <br>
+     * The search also ends early, with the same fallback, once the stop flag of workspace_wls is set
+     */
+    T wolfe_line_search(const vector<T> &x_vec_wls,
+                        const T &f_x_wls,
+                        const vector<T> &curr_gradient_wls,
+                        const vector<T> &directional_wls,
+                        const T &curvature_para,
+                        Solver_Workspace<T> &workspace_wls,
+                        T &f_trial_wls) const;
+
+    /**
+     * @brief Private member function used to reset the inverse hessian of bfgs to the inverse of the hessian
+     * of -max_or_min * f, if it is positive definite
+     * @param x_vec_rih A vector of scalars of type T that stores the current x values
+     * @param workspace_rih The workspace, its inverse_hessian is overwritten if the function returns true,
+     * its hessian, hessian_factor and inverse_hessian_product are used as scratch
+     * @return true if the hessian of -max_or_min * f is positive definite and its inverse was stored
+     */
+    bool reset_inverse_hessian(const vector<T> &x_vec_rih, Solver_Workspace<T> &workspace_rih) const;
+
+    /**
+     * @brief Private member function used to minimize the quadratic model of -max_or_min * f within the trust region
+     * with the steihaug conjugate gradient method (Nocedal and Wright, algorithm 7.2)
+     * @param x_vec_ss A vector of scalars of type T that stores the current x values
+     * @param trust_radius The radius of the trust region around the current x
+     * @param workspace_ss The workspace, its gradient must be the gradient at the current x,
+     * its direction is overwritten with the step, cg_residual, cg_direction and hessian_vector are used as scratch
+     * @return true if the step ends on the boundary of the trust region. Once the stop flag of workspace_ss is set,
+     * the iterations end early and the step computed so far is returned
+     */
+    bool steihaug_solve(const vector<T> &x_vec_ss, const T &trust_radius, Solver_Workspace<T> &workspace_ss) const;
+};
+
+// the member templates of the algorithms are defined in a header so that any observer can be used
+#include "Input_Data_algorithms.hpp"
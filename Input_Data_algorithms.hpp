@@ -0,0 +1,1011 @@
+/**
+ * @file Input_Data_algorithms.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief The optimization algorithms of Input_Data, templated on the observer of the iterations
+ *
+ * @details This file is included at the end of Input_Data.hpp, since the algorithms are member templates
+ * (see Observer.hpp) they are defined in a header so that any observer can be used
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include "Input_Data.hpp"
+#include "Polynomial.hpp"
+#include "AD_Tape.hpp"
+#include "Solver_Workspace.hpp"
+#include "matrix.hpp"
+#include "vector_overloads.hpp"
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+// ======================================================================
+// Public member functions of Input_Data: perform algorithms with an observer
+// ======================================================================
+// see Input_Data.hpp for description
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::gradient_descent(Observer &observer_gd)
+{
+    Solver_Workspace<T> workspace_gd(polyn);
+    return gradient_descent(x_initial, x_current, workspace_gd, observer_gd);
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::gradient_descent(const vector<T> &x_start_gd, vector<T> &x_current_gd,
+                                    Solver_Workspace<T> &workspace_gd, Observer &observer_gd) const
+{
+    T max_or_min_gd{static_cast<T>(min_max)};
+    const T max_norm{1000000000}; // larger norm may result in overflow
+    x_current_gd = x_start_gd;
+    vector<T> &curr_gradient_gd{workspace_gd.gradient};
+    vector<T> &curr_direction_gd{workspace_gd.direction};
+
+    // f(x) and the gradient are evaluated together by the tape, it is recorded once and reused by every iteration
+    T curr_f_gd{workspace_gd.tape.eval_f_gradient(x_current_gd, curr_gradient_gd)};
+    for (size_t curr_iter_gd{0}; curr_iter_gd < max_iter; curr_iter_gd++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_gd.stop_requested())
+                return 5;
+        T curr_norm_gd{euclidean_norm(curr_gradient_gd)};
+        if constexpr (Observer::observes_iterations)
+            observer_gd.begin_iteration(curr_iter_gd + 1, x_current_gd, curr_f_gd, curr_gradient_gd, curr_norm_gd);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_gd < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_gd > max_norm)
+            return 3;
+
+        // update step size using backtracking_line_search
+        curr_direction_gd = curr_gradient_gd; // same size, thus copied without allocating
+        curr_direction_gd *= max_or_min_gd;
+        T next_f_gd{0};
+        T step_size_gd{backtracking_line_search(x_current_gd, curr_f_gd, curr_gradient_gd, curr_direction_gd,
+                                                workspace_gd, next_f_gd)};
+        // another thread requested the algorithm to stop during the line search
+        if constexpr (Observer::can_stop)
+            if (observer_gd.stop_requested())
+                return 5;
+        if constexpr (Observer::observes_iterations)
+            observer_gd.end_iteration(step_size_gd, curr_direction_gd);
+        // the step no longer moves x, the next iterations would repeat this one until max_iter
+        if (workspace_gd.trial_x == x_current_gd)
+            return 6;
+        // move to the next x, x + step_size * direction, the line search already evaluated f and the gradient there
+        x_current_gd.swap(workspace_gd.trial_x);
+        curr_gradient_gd.swap(workspace_gd.trial_gradient);
+        curr_f_gd = next_f_gd;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::newtons_method(Observer &observer_nm)
+{
+    Solver_Workspace<T> workspace_nm(polyn);
+    return newtons_method(x_initial, x_current, workspace_nm, observer_nm);
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::newtons_method(const vector<T> &x_start_nm, vector<T> &x_current_nm,
+                                  Solver_Workspace<T> &workspace_nm, Observer &observer_nm) const
+{
+    x_current_nm = x_start_nm;
+    workspace_nm.allocate_matrices();
+    const T max_norm{1000000000}; // larger norm may result in overflow
+    vector<T> &curr_gradient_nm{workspace_nm.gradient};
+    vector<T> &curr_direction_vec{workspace_nm.direction};
+
+    for (size_t curr_iter_nm{0}; curr_iter_nm < max_iter; curr_iter_nm++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_nm.stop_requested())
+                return 5;
+        polyn.gradient_f(x_current_nm, curr_gradient_nm);
+        T curr_norm_nm{euclidean_norm(curr_gradient_nm)};
+        // f is only evaluated for the observer, newton's method itself does not need it
+        if constexpr (Observer::observes_iterations)
+            observer_nm.begin_iteration(curr_iter_nm + 1, x_current_nm, polyn.eval_f(x_current_nm),
+                                        curr_gradient_nm, curr_norm_nm);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_nm < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_nm > max_norm)
+            return 3;
+
+        // solve hessian * direction = -gradient instead of forming the inverse hessian
+        curr_direction_vec = curr_gradient_nm; // same size, thus copied without allocating
+        curr_direction_vec *= -1;
+        try
+        {
+            polyn.hessian_f(x_current_nm, workspace_nm.hessian, workspace_nm.hessian_scratch);
+            factorization hessian_kind{symmetric_factor(workspace_nm.hessian, workspace_nm.hessian_factor,
+                                                        workspace_nm.hessian_pivots)};
+            factored_solve(workspace_nm.hessian_factor, workspace_nm.hessian_pivots, hessian_kind,
+                           curr_direction_vec);
+        }
+        catch (const typename matrix<T>::singular_matrix &e)
+        {
+            // the newton direction does not exist at a singular hessian
+            return 4;
+        }
+        if constexpr (Observer::observes_iterations)
+            observer_nm.end_iteration(T{1}, curr_direction_vec); // full newton step
+        x_current_nm += curr_direction_vec;                      // move to the next x
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::lbfgs(const vector<T> &x_start_lb, vector<T> &x_current_lb,
+                         Solver_Workspace<T> &workspace_lb, Observer &observer_lb) const
+{
+    T max_or_min_lb{static_cast<T>(min_max)};
+    const T max_norm{1000000000};  // larger norm may result in overflow
+    const T curvature_para{0.9};   // wolfe parameter c2 for quasi-newton methods
+    size_t memory_lb{algorithm_options.lbfgs_memory};
+    size_t num_of_x_vars{polyn.get_num_of_x_vars()};
+    x_current_lb = x_start_lb;
+    vector<T> &curr_gradient_lb{workspace_lb.gradient};
+    vector<T> &curr_direction_lb{workspace_lb.direction};
+
+    // the history is only allocated if the workspace was not used by lbfgs with the same memory before
+    if (workspace_lb.history_s.size() != memory_lb)
+    {
+        workspace_lb.history_s.assign(memory_lb, vector<T>(num_of_x_vars));
+        workspace_lb.history_y.assign(memory_lb, vector<T>(num_of_x_vars));
+        workspace_lb.history_rho.assign(memory_lb, T{0});
+        workspace_lb.history_alpha.assign(memory_lb, T{0});
+    }
+    size_t num_of_pairs{0}; // number of (s, y) pairs stored, at most memory_lb
+    size_t newest_idx{0};   // index of the newest pair in the ring buffer
+
+    T curr_f_lb{workspace_lb.tape.eval_f_gradient(x_current_lb, curr_gradient_lb)};
+    for (size_t curr_iter_lb{0}; curr_iter_lb < max_iter; curr_iter_lb++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_lb.stop_requested())
+                return 5;
+        T curr_norm_lb{euclidean_norm(curr_gradient_lb)};
+        if constexpr (Observer::observes_iterations)
+            observer_lb.begin_iteration(curr_iter_lb + 1, x_current_lb, curr_f_lb, curr_gradient_lb, curr_norm_lb);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_lb < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_lb > max_norm)
+            return 3;
+
+        // two-loop recursion on the gradient of -max_or_min * f, from the newest pair to the oldest and back
+        curr_direction_lb = curr_gradient_lb; // same size, thus copied without allocating
+        curr_direction_lb *= -max_or_min_lb;
+        for (size_t pair_count{0}; pair_count < num_of_pairs; pair_count++)
+        {
+            size_t pair_idx{(newest_idx + memory_lb - pair_count) % memory_lb};
+            workspace_lb.history_alpha[pair_idx] =
+                workspace_lb.history_rho[pair_idx] * (workspace_lb.history_s[pair_idx] * curr_direction_lb);
+            curr_direction_lb -= workspace_lb.history_alpha[pair_idx] * workspace_lb.history_y[pair_idx];
+        }
+        // scale the initial inverse hessian with s * y / y * y of the newest pair
+        if (num_of_pairs > 0)
+        {
+            const vector<T> &newest_y{workspace_lb.history_y[newest_idx]};
+            curr_direction_lb *= T{1} / (workspace_lb.history_rho[newest_idx] * (newest_y * newest_y));
+        }
+        for (size_t pair_count{num_of_pairs}; pair_count > 0; pair_count--)
+        {
+            size_t pair_idx{(newest_idx + memory_lb - (pair_count - 1)) % memory_lb};
+            T beta_lb{workspace_lb.history_rho[pair_idx] * (workspace_lb.history_y[pair_idx] * curr_direction_lb)};
+            curr_direction_lb += (workspace_lb.history_alpha[pair_idx] - beta_lb) * workspace_lb.history_s[pair_idx];
+        }
+        curr_direction_lb *= T{-1};
+        // the direction must improve f, otherwise the history is dropped and the gradient is used
+        if (max_or_min_lb * (curr_gradient_lb * curr_direction_lb) <= 0)
+        {
+            num_of_pairs = 0;
+            curr_direction_lb = curr_gradient_lb;
+            curr_direction_lb *= max_or_min_lb;
+        }
+
+        T next_f_lb{0};
+        T step_size_lb{wolfe_line_search(x_current_lb, curr_f_lb, curr_gradient_lb, curr_direction_lb,
+                                         curvature_para, workspace_lb, next_f_lb)};
+        // another thread requested the algorithm to stop during the line search
+        if constexpr (Observer::can_stop)
+            if (observer_lb.stop_requested())
+                return 5;
+        if constexpr (Observer::observes_iterations)
+            observer_lb.end_iteration(step_size_lb, curr_direction_lb);
+        // no step size improves f along the direction, the history is dropped and the gradient is tried,
+        // f cannot be improved at the precision of T if the gradient fails as well
+        if (step_size_lb == 0)
+        {
+            if (num_of_pairs == 0)
+                return 6;
+            num_of_pairs = 0;
+            continue;
+        }
+
+        // store the pair s = step_size * direction, y = change of the gradient of -max_or_min * f,
+        // skipped if the curvature y * s is not positive
+        size_t next_idx{(num_of_pairs == 0) ? 0 : (newest_idx + 1) % memory_lb};
+        vector<T> &next_s{workspace_lb.history_s[next_idx]};
+        vector<T> &next_y{workspace_lb.history_y[next_idx]};
+        next_s = workspace_lb.trial_x;
+        next_s -= x_current_lb;
+        next_y = workspace_lb.trial_gradient;
+        next_y -= curr_gradient_lb;
+        next_y *= -max_or_min_lb;
+        T curvature_lb{next_y * next_s};
+        if (curvature_lb > 0 and isfinite(curvature_lb))
+        {
+            workspace_lb.history_rho[next_idx] = T{1} / curvature_lb;
+            newest_idx = next_idx;
+            num_of_pairs = min(num_of_pairs + 1, memory_lb);
+        }
+        else if (num_of_pairs == memory_lb)
+            num_of_pairs--; // the slot of the oldest pair was overwritten
+
+        // move to the next x, the line search already evaluated f and the gradient there
+        x_current_lb.swap(workspace_lb.trial_x);
+        curr_gradient_lb.swap(workspace_lb.trial_gradient);
+        curr_f_lb = next_f_lb;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::bfgs(const vector<T> &x_start_bf, vector<T> &x_current_bf,
+                        Solver_Workspace<T> &workspace_bf, Observer &observer_bf) const
+{
+    T max_or_min_bf{static_cast<T>(min_max)};
+    const T max_norm{1000000000}; // larger norm may result in overflow
+    const T curvature_para{0.9};  // wolfe parameter c2 for quasi-newton methods
+    const string &reset_bf{algorithm_options.bfgs_reset};
+    size_t num_of_x_vars{polyn.get_num_of_x_vars()};
+    x_current_bf = x_start_bf;
+    vector<T> &curr_gradient_bf{workspace_bf.gradient};
+    vector<T> &curr_direction_bf{workspace_bf.direction};
+    vector<T> &gradient_change_bf{workspace_bf.gradient_change};
+    vector<T> &inverse_hessian_y{workspace_bf.inverse_hessian_product};
+    workspace_bf.allocate_matrices();
+    matrix<T> &inverse_hessian_bf{workspace_bf.inverse_hessian};
+
+    // start from the identity, it is scaled by y * s / y * y before the first update
+    auto reset_to_identity = [&inverse_hessian_bf, num_of_x_vars] {
+        for (size_t row_idx{0}; row_idx < num_of_x_vars; row_idx++)
+            for (size_t col_idx{row_idx}; col_idx < num_of_x_vars; col_idx++)
+                inverse_hessian_bf(row_idx, col_idx) = (row_idx == col_idx) ? T{1} : T{0};
+    };
+    reset_to_identity();
+    bool is_identity{true};
+
+    T curr_f_bf{workspace_bf.tape.eval_f_gradient(x_current_bf, curr_gradient_bf)};
+    for (size_t curr_iter_bf{0}; curr_iter_bf < max_iter; curr_iter_bf++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_bf.stop_requested())
+                return 5;
+        T curr_norm_bf{euclidean_norm(curr_gradient_bf)};
+        if constexpr (Observer::observes_iterations)
+            observer_bf.begin_iteration(curr_iter_bf + 1, x_current_bf, curr_f_bf, curr_gradient_bf, curr_norm_bf);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_bf < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_bf > max_norm)
+            return 3;
+
+        // direction = -H * gradient of -max_or_min * f
+        symmetric_multiply(inverse_hessian_bf, curr_gradient_bf, curr_direction_bf);
+        curr_direction_bf *= max_or_min_bf;
+        // rounding errors may make H indefinite, then it is reset and the gradient is used
+        if (max_or_min_bf * (curr_gradient_bf * curr_direction_bf) <= 0)
+        {
+            reset_to_identity();
+            is_identity = true;
+            curr_direction_bf = curr_gradient_bf;
+            curr_direction_bf *= max_or_min_bf;
+        }
+
+        T next_f_bf{0};
+        T step_size_bf{wolfe_line_search(x_current_bf, curr_f_bf, curr_gradient_bf, curr_direction_bf,
+                                         curvature_para, workspace_bf, next_f_bf)};
+        // another thread requested the algorithm to stop during the line search
+        if constexpr (Observer::can_stop)
+            if (observer_bf.stop_requested())
+                return 5;
+        if constexpr (Observer::observes_iterations)
+            observer_bf.end_iteration(step_size_bf, curr_direction_bf);
+        // no step size improves f along the direction, H is reset and the gradient is tried,
+        // f cannot be improved at the precision of T if the gradient fails as well
+        if (step_size_bf == 0)
+        {
+            if (is_identity)
+                return 6;
+            reset_to_identity();
+            is_identity = true;
+            continue;
+        }
+
+        // s = x_next - x overwrites the direction, y = change of the gradient of -max_or_min * f
+        curr_direction_bf = workspace_bf.trial_x;
+        curr_direction_bf -= x_current_bf;
+        gradient_change_bf = workspace_bf.trial_gradient;
+        gradient_change_bf -= curr_gradient_bf;
+        gradient_change_bf *= -max_or_min_bf;
+        T curvature_bf{gradient_change_bf * curr_direction_bf};
+
+        // move to the next x, the line search already evaluated f and the gradient there
+        x_current_bf.swap(workspace_bf.trial_x);
+        curr_gradient_bf.swap(workspace_bf.trial_gradient);
+        curr_f_bf = next_f_bf;
+
+        if (curvature_bf > 0 and isfinite(curvature_bf))
+        {
+            if (is_identity)
+            {
+                T scale_bf{curvature_bf / (gradient_change_bf * gradient_change_bf)};
+                for (size_t diag_idx{0}; diag_idx < num_of_x_vars; diag_idx++)
+                    inverse_hessian_bf(diag_idx, diag_idx) = scale_bf;
+                is_identity = false;
+            }
+            // H = (I - rho * s * y^T) * H * (I - rho * y * s^T) + rho * s * s^T, with rho = 1 / (y * s),
+            // expanded to H - rho * (H * y * s^T + s * (H * y)^T) + (rho^2 * y * H * y + rho) * s * s^T
+            T rho_bf{T{1} / curvature_bf};
+            symmetric_multiply(inverse_hessian_bf, gradient_change_bf, inverse_hessian_y);
+            T y_h_y{gradient_change_bf * inverse_hessian_y};
+            symmetric_rank_two_update(inverse_hessian_bf, curr_direction_bf, inverse_hessian_y, -rho_bf,
+                                      rho_bf * rho_bf * y_h_y + rho_bf);
+        }
+        else if (reset_bf == "hessian" and reset_inverse_hessian(x_current_bf, workspace_bf))
+            is_identity = false;
+        else if (reset_bf != "none")
+        {
+            // also used when the hessian of -max_or_min * f is not positive definite
+            reset_to_identity();
+            is_identity = true;
+        }
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::conjugate_gradient(const vector<T> &x_start_cg, vector<T> &x_current_cg,
+                                      Solver_Workspace<T> &workspace_cg, Observer &observer_cg) const
+{
+    T max_or_min_cg{static_cast<T>(min_max)};
+    const T max_norm{1000000000}; // larger norm may result in overflow
+    const T curvature_para{0.1};  // wolfe parameter c2 for nonlinear conjugate gradient methods
+    const bool is_hager_zhang{algorithm_options.cg_formula == "hager_zhang"};
+    size_t num_of_x_vars{polyn.get_num_of_x_vars()};
+    x_current_cg = x_start_cg;
+    vector<T> &curr_gradient_cg{workspace_cg.gradient};
+    vector<T> &curr_direction_cg{workspace_cg.direction};
+    vector<T> &next_gradient_cg{workspace_cg.trial_gradient};
+
+    T curr_f_cg{workspace_cg.tape.eval_f_gradient(x_current_cg, curr_gradient_cg)};
+    curr_direction_cg = curr_gradient_cg; // same size, thus copied without allocating
+    curr_direction_cg *= max_or_min_cg;
+    size_t iters_since_restart{0};
+    for (size_t curr_iter_cg{0}; curr_iter_cg < max_iter; curr_iter_cg++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_cg.stop_requested())
+                return 5;
+        T curr_norm_cg{euclidean_norm(curr_gradient_cg)};
+        if constexpr (Observer::observes_iterations)
+            observer_cg.begin_iteration(curr_iter_cg + 1, x_current_cg, curr_f_cg, curr_gradient_cg, curr_norm_cg);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_cg < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_cg > max_norm)
+            return 3;
+
+        // the direction must improve f, otherwise the algorithm restarts from the gradient direction
+        if (max_or_min_cg * (curr_gradient_cg * curr_direction_cg) <= 0)
+        {
+            curr_direction_cg = curr_gradient_cg;
+            curr_direction_cg *= max_or_min_cg;
+            iters_since_restart = 0;
+        }
+
+        T next_f_cg{0};
+        T step_size_cg{wolfe_line_search(x_current_cg, curr_f_cg, curr_gradient_cg, curr_direction_cg,
+                                         curvature_para, workspace_cg, next_f_cg)};
+        // another thread requested the algorithm to stop during the line search
+        if constexpr (Observer::can_stop)
+            if (observer_cg.stop_requested())
+                return 5;
+        if constexpr (Observer::observes_iterations)
+            observer_cg.end_iteration(step_size_cg, curr_direction_cg);
+        // no step size improves f along the direction, the algorithm restarts from the gradient direction,
+        // f cannot be improved at the precision of T if it already was the gradient direction
+        if (step_size_cg == 0)
+        {
+            if (iters_since_restart == 0)
+                return 6;
+            curr_direction_cg = curr_gradient_cg;
+            curr_direction_cg *= max_or_min_cg;
+            iters_since_restart = 0;
+            continue;
+        }
+
+        // beta only needs dot products of the gradients g, g_next and the direction d, with the gradient of
+        // -max_or_min * f the signs cancel, y = g_next - g up to the sign of max_or_min
+        T beta_cg{0};
+        iters_since_restart++;
+        if (iters_since_restart < num_of_x_vars)
+        {
+            T next_next_dot{next_gradient_cg * next_gradient_cg};
+            T next_curr_dot{next_gradient_cg * curr_gradient_cg};
+            T curr_curr_dot{curr_gradient_cg * curr_gradient_cg};
+            T y_next_dot{next_next_dot - next_curr_dot}; // y * g_next
+            if (is_hager_zhang)
+            {
+                T dir_y_dot{max_or_min_cg * (curr_direction_cg * curr_gradient_cg - curr_direction_cg * next_gradient_cg)};
+                T y_y_dot{next_next_dot - 2 * next_curr_dot + curr_curr_dot};
+                T dir_next_dot{-max_or_min_cg * (curr_direction_cg * next_gradient_cg)};
+                // the strong wolfe conditions give d * y > 0, unless the line search failed
+                if (dir_y_dot > 0 and isfinite(dir_y_dot))
+                {
+                    beta_cg = (y_next_dot - 2 * y_y_dot * dir_next_dot / dir_y_dot) / dir_y_dot;
+                    // the lower bound eta of Hager and Zhang keeps the direction an improving direction
+                    T eta_cg{T{-1} / (euclidean_norm(curr_direction_cg) * min(T{0.01}, sqrt(curr_curr_dot)))};
+                    beta_cg = max(beta_cg, eta_cg);
+                }
+            }
+            else
+                beta_cg = max(T{0}, y_next_dot / curr_curr_dot);
+            if (!isfinite(beta_cg))
+                beta_cg = 0;
+        }
+        if (beta_cg == 0)
+            iters_since_restart = 0;
+
+        // move to the next x, the line search already evaluated f and the gradient there
+        x_current_cg.swap(workspace_cg.trial_x);
+        curr_gradient_cg.swap(next_gradient_cg);
+        curr_f_cg = next_f_cg;
+        curr_direction_cg *= beta_cg;
+        curr_direction_cg += max_or_min_cg * curr_gradient_cg;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::trust_region(const vector<T> &x_start_tr, vector<T> &x_current_tr,
+                                Solver_Workspace<T> &workspace_tr, Observer &observer_tr) const
+{
+    T max_or_min_tr{static_cast<T>(min_max)};
+    const T max_norm{1000000000}; // larger norm may result in overflow
+    const T max_radius{1000};     // largest radius of the trust region
+    const T accept_ratio{0.1};    // smallest ratio of the actual to the predicted improvement of an accepted step
+    T trust_radius{1};
+    x_current_tr = x_start_tr;
+    vector<T> &curr_gradient_tr{workspace_tr.gradient};
+    vector<T> &curr_step_tr{workspace_tr.direction};
+
+    T curr_f_tr{workspace_tr.tape.eval_f_gradient(x_current_tr, curr_gradient_tr)};
+    for (size_t curr_iter_tr{0}; curr_iter_tr < max_iter; curr_iter_tr++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_tr.stop_requested())
+                return 5;
+        T curr_norm_tr{euclidean_norm(curr_gradient_tr)};
+        if constexpr (Observer::observes_iterations)
+            observer_tr.begin_iteration(curr_iter_tr + 1, x_current_tr, curr_f_tr, curr_gradient_tr, curr_norm_tr);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_tr < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_tr > max_norm)
+            return 3;
+
+        bool on_boundary{steihaug_solve(x_current_tr, trust_radius, workspace_tr)};
+        // another thread requested the algorithm to stop during the subproblem
+        if constexpr (Observer::can_stop)
+            if (observer_tr.stop_requested())
+                return 5;
+
+        // improvement of max_or_min * f predicted by the quadratic model, and the actual improvement
+        polyn.hessian_vector_f(x_current_tr, curr_step_tr, workspace_tr.hessian_vector, workspace_tr.hessian_scratch);
+        T predicted_tr{max_or_min_tr * (curr_gradient_tr * curr_step_tr +
+                                        T{0.5} * (curr_step_tr * workspace_tr.hessian_vector))};
+        workspace_tr.trial_x = x_current_tr;
+        workspace_tr.trial_x += curr_step_tr;
+        T next_f_tr{workspace_tr.tape.eval_f_gradient(workspace_tr.trial_x, workspace_tr.trial_gradient)};
+        T actual_tr{max_or_min_tr * (next_f_tr - curr_f_tr)};
+        T ratio_tr{actual_tr / predicted_tr};
+
+        // shrink the region if the model is poor (or the ratio is nan), grow it if the model is good
+        // and the step was limited by the region
+        if (!(predicted_tr > 0) or !(ratio_tr >= T{0.25}))
+            trust_radius *= T{0.25};
+        else if (ratio_tr > T{0.75} and on_boundary)
+            trust_radius = min(2 * trust_radius, max_radius);
+        bool is_accepted{predicted_tr > 0 and ratio_tr > accept_ratio and isfinite(next_f_tr)};
+        if constexpr (Observer::observes_iterations)
+            observer_tr.end_iteration(is_accepted ? T{1} : T{0}, curr_step_tr);
+
+        if (is_accepted)
+        {
+            // move to the next x, f and the gradient were already evaluated there
+            x_current_tr.swap(workspace_tr.trial_x);
+            curr_gradient_tr.swap(workspace_tr.trial_gradient);
+            curr_f_tr = next_f_tr;
+        }
+        // a step within a smaller region no longer moves x at the precision of T,
+        // the region would shrink at every iteration until it underflows
+        if (trust_radius < numeric_limits<T>::epsilon() * max(euclidean_norm(x_current_tr), T{1}))
+            return 6;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::levenberg_marquardt(const vector<T> &x_start_lm, vector<T> &x_current_lm,
+                                       Solver_Workspace<T> &workspace_lm, Observer &observer_lm) const
+{
+    T max_or_min_lm{static_cast<T>(min_max)};
+    const T max_norm{1000000000}; // larger norm may result in overflow
+    const T curvature_para{0.9};  // wolfe parameter c2 for newton-like methods
+    const size_t max_damping_trials{100};
+    size_t num_of_x_vars{polyn.get_num_of_x_vars()};
+    x_current_lm = x_start_lm;
+    workspace_lm.allocate_matrices();
+    vector<T> &curr_gradient_lm{workspace_lm.gradient};
+    vector<T> &curr_direction_lm{workspace_lm.direction};
+    matrix<T> &hessian_lm{workspace_lm.hessian};
+    matrix<T> &damped_factor{workspace_lm.hessian_factor};
+    T damping_lm{0}; // starts as newton's method
+
+    T curr_f_lm{workspace_lm.tape.eval_f_gradient(x_current_lm, curr_gradient_lm)};
+    for (size_t curr_iter_lm{0}; curr_iter_lm < max_iter; curr_iter_lm++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_lm.stop_requested())
+                return 5;
+        T curr_norm_lm{euclidean_norm(curr_gradient_lm)};
+        if constexpr (Observer::observes_iterations)
+            observer_lm.begin_iteration(curr_iter_lm + 1, x_current_lm, curr_f_lm, curr_gradient_lm, curr_norm_lm);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_lm < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_lm > max_norm)
+            return 3;
+
+        // the hessian of -max_or_min * f, the damping is relative to the size of its diagonal
+        polyn.hessian_f(x_current_lm, hessian_lm, workspace_lm.hessian_scratch);
+        T diagonal_scale{1};
+        for (size_t row_idx{0}; row_idx < num_of_x_vars; row_idx++)
+        {
+            for (size_t col_idx{0}; col_idx < num_of_x_vars; col_idx++)
+                hessian_lm(row_idx, col_idx) *= -max_or_min_lm;
+            diagonal_scale = max(diagonal_scale, abs(hessian_lm(row_idx, row_idx)));
+        }
+        if (damping_lm < numeric_limits<T>::epsilon() * diagonal_scale)
+            damping_lm = 0;
+
+        // increase the damping until the damped hessian is positive definite
+        for (size_t damping_trial{0};; damping_trial++)
+        {
+            if (damping_trial == max_damping_trials or !isfinite(damping_lm))
+                return 4;
+            // each trial factorizes the hessian, another thread may have requested the algorithm to stop
+            if constexpr (Observer::can_stop)
+                if (observer_lm.stop_requested())
+                    return 5;
+            damped_factor = hessian_lm; // same size, thus copied without allocating
+            for (size_t diag_idx{0}; diag_idx < num_of_x_vars; diag_idx++)
+                damped_factor(diag_idx, diag_idx) += damping_lm;
+            if (cholesky_factor(damped_factor))
+                break;
+            damping_lm = (damping_lm == 0) ? T{0.001} * diagonal_scale : 4 * damping_lm;
+        }
+        curr_direction_lm = curr_gradient_lm; // same size, thus copied without allocating
+        curr_direction_lm *= max_or_min_lm;
+        cholesky_solve(damped_factor, curr_direction_lm);
+
+        T next_f_lm{0};
+        T step_size_lm{wolfe_line_search(x_current_lm, curr_f_lm, curr_gradient_lm, curr_direction_lm,
+                                         curvature_para, workspace_lm, next_f_lm)};
+        // another thread requested the algorithm to stop during the line search
+        if constexpr (Observer::can_stop)
+            if (observer_lm.stop_requested())
+                return 5;
+        if constexpr (Observer::observes_iterations)
+            observer_lm.end_iteration(step_size_lm, curr_direction_lm);
+        // no step size improves f along the direction (or the step no longer moves x), the damping is increased
+        // much faster and the step is retried from the same x, f cannot be improved at the precision of T if the
+        // damping already dominates the hessian, the direction is then the gradient direction
+        if (step_size_lm == 0 or workspace_lm.trial_x == x_current_lm)
+        {
+            if (damping_lm > diagonal_scale / numeric_limits<T>::epsilon())
+                return 6;
+            damping_lm = max(16 * damping_lm, T{0.001} * diagonal_scale);
+            continue;
+        }
+        // a full (or longer) step means the damping is too large, less damping moves closer to newton's method,
+        // a shorter step means the newton model is poor, more damping moves closer to gradient descent,
+        // also if the damping was 0
+        damping_lm = (step_size_lm >= 1) ? damping_lm / 4 : max(2 * damping_lm, T{0.001} * diagonal_scale);
+
+        // move to the next x, the line search already evaluated f and the gradient there
+        x_current_lm.swap(workspace_lm.trial_x);
+        curr_gradient_lm.swap(workspace_lm.trial_gradient);
+        curr_f_lm = next_f_lm;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::shamanskii(const vector<T> &x_start_sh, vector<T> &x_current_sh,
+                              Solver_Workspace<T> &workspace_sh, Observer &observer_sh) const
+{
+    const T max_norm{1000000000};  // larger norm may result in overflow
+    const T progress_ratio{0.5};   // a step with a reused factorization must multiply the gradient norm by at most this
+    size_t refactor_interval{algorithm_options.refactor_interval};
+    x_current_sh = x_start_sh;
+    workspace_sh.allocate_matrices();
+    workspace_sh.num_of_factorizations = 0;
+    workspace_sh.num_of_skipped_factorizations = 0;
+    vector<T> &curr_gradient_sh{workspace_sh.gradient};
+    vector<T> &curr_direction_sh{workspace_sh.direction};
+    factorization hessian_kind{factorization::lu};
+    size_t factor_age{0};   // number of iterations that used the current factorization, 0 if there is none
+    T prev_norm_sh{0};      // the gradient norm of the previous iteration
+
+    for (size_t curr_iter_sh{0}; curr_iter_sh < max_iter; curr_iter_sh++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_sh.stop_requested())
+                return 5;
+        polyn.gradient_f(x_current_sh, curr_gradient_sh);
+        T curr_norm_sh{euclidean_norm(curr_gradient_sh)};
+        // f is only evaluated for the observer, the algorithm itself does not need it
+        if constexpr (Observer::observes_iterations)
+            observer_sh.begin_iteration(curr_iter_sh + 1, x_current_sh, polyn.eval_f(x_current_sh),
+                                        curr_gradient_sh, curr_norm_sh);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_sh < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_sh > max_norm)
+            return 3;
+
+        // factor the hessian again if there is no factorization, it is too old,
+        // or the step taken with it did not make enough progress
+        if (factor_age == 0 or factor_age >= refactor_interval or !(curr_norm_sh <= progress_ratio * prev_norm_sh))
+        {
+            try
+            {
+                polyn.hessian_f(x_current_sh, workspace_sh.hessian, workspace_sh.hessian_scratch);
+                hessian_kind = symmetric_factor(workspace_sh.hessian, workspace_sh.hessian_factor,
+                                                workspace_sh.hessian_pivots);
+            }
+            catch (const typename matrix<T>::singular_matrix &e)
+            {
+                // the newton direction does not exist at a singular hessian
+                return 4;
+            }
+            workspace_sh.num_of_factorizations++;
+            factor_age = 0;
+        }
+        else
+            workspace_sh.num_of_skipped_factorizations++;
+
+        // solve hessian * direction = -gradient with the current factorization
+        curr_direction_sh = curr_gradient_sh; // same size, thus copied without allocating
+        curr_direction_sh *= -1;
+        factored_solve(workspace_sh.hessian_factor, workspace_sh.hessian_pivots, hessian_kind, curr_direction_sh);
+        if constexpr (Observer::observes_iterations)
+            observer_sh.end_iteration(T{1}, curr_direction_sh); // full newton step
+        x_current_sh += curr_direction_sh;                      // move to the next x
+        factor_age++;
+        prev_norm_sh = curr_norm_sh;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::barzilai_borwein(const vector<T> &x_start_bb, vector<T> &x_current_bb,
+                                    Solver_Workspace<T> &workspace_bb, Observer &observer_bb) const
+{
+    T max_or_min_bb{static_cast<T>(min_max)};
+    const T max_norm{1000000000};    // larger norm may result in overflow
+    const T sufficient_para{0.0001}; // parameter of the nonmonotone sufficient improvement condition
+    const T min_spectral{1e-10};     // the spectral step size is kept in [min_spectral, max_spectral]
+    const T max_spectral{1e10};
+    const size_t max_trials{60};     // maximum number of evaluations of f and the gradient per iteration
+    size_t memory_bb{algorithm_options.nonmonotone_memory};
+    x_current_bb = x_start_bb;
+    vector<T> &curr_gradient_bb{workspace_bb.gradient};
+    vector<T> &curr_direction_bb{workspace_bb.direction};
+    vector<T> &trial_x_bb{workspace_bb.trial_x};
+    vector<T> &trial_gradient_bb{workspace_bb.trial_gradient};
+
+    // ring buffer of the last values of -max_or_min * f, the reference value is the worst of them
+    vector<T> &recent_phi{workspace_bb.recent_phi};
+    recent_phi.assign(memory_bb, T{0}); // only allocates if the workspace had a smaller memory
+    size_t num_of_recent{0};
+
+    T curr_f_bb{workspace_bb.tape.eval_f_gradient(x_current_bb, curr_gradient_bb)};
+    T spectral_bb{0}; // step size of the first iteration, the gradient step of length 1
+    for (size_t curr_iter_bb{0}; curr_iter_bb < max_iter; curr_iter_bb++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_bb.stop_requested())
+                return 5;
+        T curr_norm_bb{euclidean_norm(curr_gradient_bb)};
+        if constexpr (Observer::observes_iterations)
+            observer_bb.begin_iteration(curr_iter_bb + 1, x_current_bb, curr_f_bb, curr_gradient_bb, curr_norm_bb);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_bb < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_bb > max_norm)
+            return 3;
+
+        T curr_phi{-max_or_min_bb * curr_f_bb};
+        recent_phi[curr_iter_bb % memory_bb] = curr_phi;
+        num_of_recent = min(num_of_recent + 1, memory_bb);
+        T reference_phi{*max_element(recent_phi.begin(), recent_phi.begin() + num_of_recent)};
+        bool restarted_bb{spectral_bb == 0}; // the search starts from the gradient step of length 1
+        if (restarted_bb)
+            spectral_bb = T{1} / curr_norm_bb;
+
+        // nonmonotone line search along the gradient direction, starting at the spectral step size,
+        // a rejected step size is reduced to the minimizer of the quadratic interpolation, within [0.1, 0.5] of it
+        curr_direction_bb = curr_gradient_bb; // same size, thus copied without allocating
+        curr_direction_bb *= max_or_min_bb;
+        T dphi_0{-curr_norm_bb * curr_norm_bb}; // derivative of -max_or_min * f along the direction
+        T step_size_bb{spectral_bb};
+        T next_f_bb{0};
+        bool accepted_bb{false};
+        for (size_t trial_idx{0}; trial_idx < max_trials; trial_idx++)
+        {
+            // another thread requested the algorithm to stop during the line search
+            if constexpr (Observer::can_stop)
+                if (observer_bb.stop_requested())
+                    return 5;
+            trial_x_bb = x_current_bb;
+            trial_x_bb += step_size_bb * curr_direction_bb;
+            // the step no longer moves x, the condition might never hold because of rounding errors
+            if (trial_x_bb == x_current_bb)
+                break;
+            next_f_bb = workspace_bb.tape.eval_f_gradient(trial_x_bb, trial_gradient_bb);
+            T next_phi{-max_or_min_bb * next_f_bb};
+            if (isfinite(next_phi) and next_phi <= reference_phi + sufficient_para * step_size_bb * dphi_0)
+            {
+                accepted_bb = true;
+                break;
+            }
+            T denominator{2 * (next_phi - curr_phi - step_size_bb * dphi_0)};
+            T interpolated_step{step_size_bb / 2};
+            if (isfinite(denominator) and denominator > 0)
+                interpolated_step = -dphi_0 * step_size_bb * step_size_bb / denominator;
+            step_size_bb = max(min(interpolated_step, step_size_bb / 2), step_size_bb / 10);
+        }
+        if constexpr (Observer::observes_iterations)
+            observer_bb.end_iteration(accepted_bb ? step_size_bb : T{0}, curr_direction_bb);
+        // the step no longer moves x, f cannot be improved at the precision of T
+        if (trial_x_bb == x_current_bb)
+            return 6;
+        // every trial failed, x is not moved and the search is retried from the gradient step of length 1,
+        // f cannot be improved at the precision of T if the search already started from there
+        if (!accepted_bb)
+        {
+            if (restarted_bb)
+                return 6;
+            spectral_bb = 0;
+            continue;
+        }
+
+        // spectral step size s * s / s * y of the gradient of -max_or_min * f,
+        // with s = step_size * direction and y = -max_or_min * (gradient_next - gradient)
+        T s_s_dot{0}, s_y_dot{0};
+        for (size_t x_idx{0}; x_idx < x_current_bb.size(); x_idx++)
+        {
+            T s_bb{trial_x_bb[x_idx] - x_current_bb[x_idx]};
+            s_s_dot += s_bb * s_bb;
+            s_y_dot += -max_or_min_bb * s_bb * (trial_gradient_bb[x_idx] - curr_gradient_bb[x_idx]);
+        }
+        // negative curvature along s, the next step size is the maximum
+        spectral_bb = (s_y_dot > 0) ? max(min(s_s_dot / s_y_dot, max_spectral), min_spectral) : max_spectral;
+        if (!isfinite(spectral_bb) or s_s_dot == 0)
+            spectral_bb = 0; // restart from the gradient step of length 1
+
+        // move to the next x, f and the gradient were already evaluated there
+        x_current_bb.swap(trial_x_bb);
+        curr_gradient_bb.swap(trial_gradient_bb);
+        curr_f_bb = next_f_bb;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::nesterov(const vector<T> &x_start_na, vector<T> &x_current_na,
+                            Solver_Workspace<T> &workspace_na, Observer &observer_na) const
+{
+    T max_or_min_na{static_cast<T>(min_max)};
+    const T max_norm{1000000000}; // larger norm may result in overflow
+    T learning_rate_na{static_cast<T>(algorithm_options.learning_rate)};
+    // x_current is the extrapolated point where the gradient is evaluated,
+    // previous_x is the point reached by the last gradient step
+    x_current_na = x_start_na;
+    vector<T> &curr_gradient_na{workspace_na.gradient};
+    vector<T> &curr_direction_na{workspace_na.direction};
+    vector<T> &next_x_na{workspace_na.trial_x};
+    vector<T> &previous_x_na{workspace_na.previous_x};
+    previous_x_na = x_start_na; // same size, thus copied without allocating
+
+    T theta_na{1}; // momentum parameter, 1 after a restart
+    for (size_t curr_iter_na{0}; curr_iter_na < max_iter; curr_iter_na++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_na.stop_requested())
+                return 5;
+        T curr_f_na{workspace_na.tape.eval_f_gradient(x_current_na, curr_gradient_na)};
+        T curr_norm_na{euclidean_norm(curr_gradient_na)};
+        if constexpr (Observer::observes_iterations)
+            observer_na.begin_iteration(curr_iter_na + 1, x_current_na, curr_f_na, curr_gradient_na, curr_norm_na);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_na < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_na > max_norm)
+            return 3;
+
+        // gradient step from the extrapolated point
+        next_x_na = x_current_na;
+        next_x_na += (learning_rate_na * max_or_min_na) * curr_gradient_na;
+
+        // restart if the gradient of -max_or_min * f points along the last step, the momentum then goes uphill
+        T restart_dot{0};
+        for (size_t x_idx{0}; x_idx < x_current_na.size(); x_idx++)
+            restart_dot += -max_or_min_na * curr_gradient_na[x_idx] * (next_x_na[x_idx] - previous_x_na[x_idx]);
+        T momentum_na{0};
+        if (restart_dot > 0)
+            theta_na = 1;
+        else
+        {
+            T next_theta_na{(1 + sqrt(1 + 4 * theta_na * theta_na)) / 2};
+            momentum_na = (theta_na - 1) / next_theta_na;
+            theta_na = next_theta_na;
+        }
+
+        // the next extrapolated point is next_x + momentum * (next_x - previous_x)
+        for (size_t x_idx{0}; x_idx < x_current_na.size(); x_idx++)
+            curr_direction_na[x_idx] = (next_x_na[x_idx] - x_current_na[x_idx]) +
+                                       momentum_na * (next_x_na[x_idx] - previous_x_na[x_idx]);
+        // the direction is the whole step, thus the step size is 1
+        if constexpr (Observer::observes_iterations)
+            observer_na.end_iteration(T{1}, curr_direction_na);
+        x_current_na += curr_direction_na;
+        previous_x_na.swap(next_x_na);
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::adam(const vector<T> &x_start_ad, vector<T> &x_current_ad,
+                        Solver_Workspace<T> &workspace_ad, Observer &observer_ad) const
+{
+    T max_or_min_ad{static_cast<T>(min_max)};
+    const T max_norm{1000000000};   // larger norm may result in overflow
+    const T first_decay{0.9};       // decay rate of the moving average of the gradient
+    const T second_decay{0.999};    // decay rate of the moving average of the squared gradient
+    const T denominator_para{1e-8}; // added to the denominator of the step, so it is never divided by zero
+    T learning_rate_ad{static_cast<T>(algorithm_options.learning_rate)};
+    x_current_ad = x_start_ad;
+    vector<T> &curr_gradient_ad{workspace_ad.gradient};
+    vector<T> &curr_direction_ad{workspace_ad.direction};
+    vector<T> &first_moment_ad{workspace_ad.first_moment};
+    vector<T> &second_moment_ad{workspace_ad.second_moment};
+    fill(first_moment_ad.begin(), first_moment_ad.end(), T{0});
+    fill(second_moment_ad.begin(), second_moment_ad.end(), T{0});
+
+    // first_decay^t and second_decay^t, to correct the bias of the moving averages towards their initial value 0
+    T first_decay_power{1}, second_decay_power{1};
+    for (size_t curr_iter_ad{0}; curr_iter_ad < max_iter; curr_iter_ad++)
+    {
+        // another thread requested the algorithm to stop, for example the winner of a race
+        if constexpr (Observer::can_stop)
+            if (observer_ad.stop_requested())
+                return 5;
+        T curr_f_ad{workspace_ad.tape.eval_f_gradient(x_current_ad, curr_gradient_ad)};
+        T curr_norm_ad{euclidean_norm(curr_gradient_ad)};
+        if constexpr (Observer::observes_iterations)
+            observer_ad.begin_iteration(curr_iter_ad + 1, x_current_ad, curr_f_ad, curr_gradient_ad, curr_norm_ad);
+        // found a local minimum if the norm of the current gradient is with the tolerance
+        if (curr_norm_ad < tolerance)
+            return 1;
+        // larger norm may result in overflow
+        if (curr_norm_ad > max_norm)
+            return 3;
+
+        first_decay_power *= first_decay;
+        second_decay_power *= second_decay;
+        for (size_t x_idx{0}; x_idx < x_current_ad.size(); x_idx++)
+        {
+            // moving averages of the gradient of -max_or_min * f and of its square
+            T phi_gradient{-max_or_min_ad * curr_gradient_ad[x_idx]};
+            first_moment_ad[x_idx] = first_decay * first_moment_ad[x_idx] + (1 - first_decay) * phi_gradient;
+            second_moment_ad[x_idx] = second_decay * second_moment_ad[x_idx] + (1 - second_decay) * phi_gradient * phi_gradient;
+            T first_corrected{first_moment_ad[x_idx] / (1 - first_decay_power)};
+            T second_corrected{second_moment_ad[x_idx] / (1 - second_decay_power)};
+            curr_direction_ad[x_idx] = -first_corrected / (sqrt(second_corrected) + denominator_para);
+        }
+        if constexpr (Observer::observes_iterations)
+            observer_ad.end_iteration(learning_rate_ad, curr_direction_ad);
+        x_current_ad += learning_rate_ad * curr_direction_ad;
+    };
+    return 2;
+}
+
+template <typename T>
+template <typename Observer>
+int Input_Data<T>::run_algorithm(const string &algorithm_str, const vector<T> &x_start_ra, vector<T> &x_current_ra,
+                                 Solver_Workspace<T> &workspace_ra, Observer &observer_ra) const
+{
+    if (algorithm_str == "gradient_descent")
+        return gradient_descent(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "newtons_method")
+        return newtons_method(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "lbfgs")
+        return lbfgs(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "bfgs")
+        return bfgs(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "conjugate_gradient")
+        return conjugate_gradient(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "trust_region")
+        return trust_region(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "levenberg_marquardt")
+        return levenberg_marquardt(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "shamanskii")
+        return shamanskii(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "barzilai_borwein")
+        return barzilai_borwein(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "nesterov")
+        return nesterov(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    if (algorithm_str == "adam")
+        return adam(x_start_ra, x_current_ra, workspace_ra, observer_ra);
+    throw err_unknown_algorithm();
+}
@@ -1,8 +1,13 @@
-#include <fstream>
+#include <algorithm>
+#include <string>
 #include <vector>
 #include <cmath>
 #include "Input_Data.hpp"
 #include "Polynomial.hpp"
+#include "Iteration_Trace.hpp"
+#include "Observer.hpp"
+#include "Solver_Workspace.hpp"
+#include "Algorithm_Options.hpp"
 #include "matrix.hpp"
 #include "vector_overloads.hpp"
 #include "Error_Handling.hpp"
@@ -14,9 +19,10 @@
 
 using namespace std;
 
-long double Input_Data::euclidean_norm(const vector<long double> &vec_en) const
+template <typename T>
+T Input_Data<T>::euclidean_norm(const vector<T> &vec_en) const
 {
-    long double result_en{0}; // initialize the return value to be 0
+    T result_en{0}; // initialize the return value to be 0
     size_t vec_size_en{vec_en.size()};
     for (size_t value_idx_en{0}; value_idx_en < vec_size_en; value_idx_en++)
     {
@@ -26,119 +32,346 @@ long double Input_Data::euclidean_norm(const vector<long double> &vec_en) const
     return sqrt(result_en);
 }
 
-long double Input_Data::backtracking_line_search(const vector<long double> &x_vec_bls,
-                                                 const vector<long double> &curr_gradient_bls,
-                                                 const vector<long double> &directional_bls) const
+template <typename T>
+T Input_Data<T>::backtracking_line_search(const vector<T> &x_vec_bls,
+                                          const T &f_x_bls,
+                                          const vector<T> &curr_gradient_bls,
+                                          const vector<T> &directional_bls,
+                                          Solver_Workspace<T> &workspace_bls,
+                                          T &f_trial_bls) const
 {
-    long double max_or_min_bls{min_max * 1.0L};   // convert min_max to a long double
-    constexpr long double control_para_c{0.5L};   // search control parameter c in the interval [0, 1]
-    constexpr long double control_para_tao{0.5L}; // search control parameter tao in the interval [0, 1]
-    long double step_size_bls{1};                 // start from step size 1
-    long double eval_f_x_bls{polyn.eval_f(x_vec_bls)};
-    long double lhs_cond{polyn.eval_f(x_vec_bls + step_size_bls * directional_bls) - eval_f_x_bls};
-    long double rhs_cond{control_para_c * step_size_bls * curr_gradient_bls * directional_bls};
+    T max_or_min_bls{static_cast<T>(min_max)};  // convert min_max to a scalar
+    const T control_para_c{0.5};                // search control parameter c in the interval [0, 1]
+    const T control_para_tao{0.5};              // search control parameter tao in the interval [0, 1]
+    vector<T> &trial_x_bls{workspace_bls.trial_x};
+    vector<T> &trial_gradient_bls{workspace_bls.trial_gradient};
+    T step_size_bls{1};                 // start from step size 1
+    trial_x_bls = x_vec_bls;            // same size, thus copied without allocating
+    trial_x_bls += step_size_bls * directional_bls;
+    // f(x) and f at the trial x are both evaluated by the forward sweep of the tape, so that they only
+    // differ by the change of x, and not by the rounding errors of two different evaluations
+    f_trial_bls = workspace_bls.tape.eval_f(trial_x_bls);
+    T lhs_cond{f_trial_bls - f_x_bls};
+    T rhs_cond{control_para_c * step_size_bls * curr_gradient_bls * directional_bls};
     while (lhs_cond * max_or_min_bls < rhs_cond * max_or_min_bls)
     {
         // update the step size and its conditions
         step_size_bls *= control_para_tao;
-        lhs_cond = polyn.eval_f(x_vec_bls + step_size_bls * directional_bls) - eval_f_x_bls;
+        trial_x_bls = x_vec_bls;
+        trial_x_bls += step_size_bls * directional_bls;
+        // the step no longer moves x, f cannot be improved at the precision of T,
+        // or another thread requested the algorithm to stop
+        if (trial_x_bls == x_vec_bls or workspace_bls.stop_requested())
+            break;
+        f_trial_bls = workspace_bls.tape.eval_f(trial_x_bls);
+        lhs_cond = f_trial_bls - f_x_bls;
         rhs_cond = control_para_c * step_size_bls * curr_gradient_bls * directional_bls;
     }
+    // the last forward sweep was at the accepted trial x, only its gradient needs the backward sweep
+    if (trial_x_bls != x_vec_bls)
+        workspace_bls.tape.gradient_of_last_sweep(trial_gradient_bls);
     return step_size_bls;
 }
 
-// ======================================================================
-// Public member functions of Input_Data: evaluate/perform algorithms
-// ======================================================================
-// see Input_Data.hpp for description
-
-int Input_Data::gradient_descent()
+template <typename T>
+T Input_Data<T>::wolfe_line_search(const vector<T> &x_vec_wls,
+                                   const T &f_x_wls,
+                                   const vector<T> &curr_gradient_wls,
+                                   const vector<T> &directional_wls,
+                                   const T &curvature_para,
+                                   Solver_Workspace<T> &workspace_wls,
+                                   T &f_trial_wls) const
 {
-    long double max_or_min_gd{min_max * 1.0L};
-    constexpr long double max_norm{1000000000}; // larger norm may result in overflow
-    x_current = x_initial;
+    // phi(step) = -max_or_min * f(x + step * direction) is minimized, for both a minimization and a maximization
+    T max_or_min_wls{static_cast<T>(min_max)};
+    const T sufficient_para{0.0001}; // parameter c1 of the sufficient decrease condition
+    const size_t max_trials{60};     // maximum number of evaluations of f and the gradient
+    vector<T> &trial_x_wls{workspace_wls.trial_x};
+    vector<T> &trial_gradient_wls{workspace_wls.trial_gradient};
+    T phi_0{-max_or_min_wls * f_x_wls};
+    T dphi_0{-max_or_min_wls * (curr_gradient_wls * directional_wls)};
 
-    ofstream store_iters_gd{"output_iterations_gradient_descent.txt"};
-    if (!store_iters_gd)
-        throw err_fail_to_read_iter_txt();
+    // evaluate phi and its derivative at a step size, trial_x and trial_gradient are overwritten
+    auto evaluate_phi = [&](const T &step_ep, T &dphi_ep) {
+        trial_x_wls = x_vec_wls; // same size, thus copied without allocating
+        trial_x_wls += step_ep * directional_wls;
+        f_trial_wls = workspace_wls.tape.eval_f_gradient(trial_x_wls, trial_gradient_wls);
+        dphi_ep = -max_or_min_wls * (trial_gradient_wls * directional_wls);
+        return -max_or_min_wls * f_trial_wls;
+    };
 
-    for (size_t curr_iter_gd{0}; curr_iter_gd < max_iter; curr_iter_gd++)
+    // bracketing phase: increase the step size until [step_lo, step_hi] contains acceptable step sizes
+    T step_lo{0}, phi_lo{phi_0}, dphi_lo{dphi_0};
+    T step_hi{0}, phi_hi{phi_0};
+    T step_wls{1};
+    size_t trial_idx{0};
+    bool bracketed{false};
+    // the search ends early if another thread requested the algorithm to stop
+    for (; trial_idx < max_trials and !bracketed and !workspace_wls.stop_requested(); trial_idx++)
     {
-        vector<long double> curr_gradient_gd{polyn.gradient_f(x_current)};
-
-        store_iters_gd << "Iteration " << curr_iter_gd + 1 << ": " << '\n';     // store each iteration
-        store_iters_gd.precision(10);                                           // store each iteration
-        store_iters_gd << "Current_x: " << x_current;                           // store each iteration
-        store_iters_gd << "Gradient: " << curr_gradient_gd;                     // store each iteration
-        store_iters_gd << "Norm: " << euclidean_norm(curr_gradient_gd) << '\n'; // store each iteration
-        // found a local minimum if the norm of the current gradient is with the tolerance
-        if (euclidean_norm(curr_gradient_gd) < tolerance)
+        T dphi_step{0};
+        T phi_step{evaluate_phi(step_wls, dphi_step)};
+        if (!isfinite(phi_step) or phi_step > phi_0 + sufficient_para * step_wls * dphi_0 or
+            (trial_idx > 0 and phi_step >= phi_lo))
+        {
+            step_hi = step_wls;
+            phi_hi = phi_step;
+            bracketed = true;
+        }
+        else if (abs(dphi_step) <= -curvature_para * dphi_0)
+            return step_wls;
+        else if (dphi_step >= 0)
         {
-            store_iters_gd.close();
-            return 1;
+            step_hi = step_lo;
+            phi_hi = phi_lo;
+            step_lo = step_wls;
+            phi_lo = phi_step;
+            dphi_lo = dphi_step;
+            bracketed = true;
         }
-        // larger norm may result in overflow
-        if (euclidean_norm(curr_gradient_gd) > max_norm)
+        else
         {
-            store_iters_gd.close();
-            return 3;
+            step_lo = step_wls;
+            phi_lo = phi_step;
+            dphi_lo = dphi_step;
+            step_wls *= 2;
         }
+    }
 
-        // update step size using backtracking_line_search
-        long double step_size_gd{backtracking_line_search(x_current, curr_gradient_gd,
-                                                          max_or_min_gd * curr_gradient_gd)};
-        store_iters_gd << "Step_size: " << step_size_gd << '\n';      // store each iteration
-        x_current += max_or_min_gd * step_size_gd * curr_gradient_gd; // move to the next x
-        store_iters_gd << "Next_x: " << x_current << '\n';            // store each iteration
-    };
-    store_iters_gd.close();
-    return 2;
+    // zoom phase: shrink [step_lo, step_hi], step_lo always satisfies the sufficient decrease condition
+    for (; bracketed and trial_idx < max_trials and !workspace_wls.stop_requested(); trial_idx++)
+    {
+        // minimizer of the quadratic through phi_lo, dphi_lo and phi_hi, kept away from the ends of the interval
+        T width{step_hi - step_lo};
+        T denominator{2 * (phi_hi - phi_lo - dphi_lo * width)};
+        step_wls = step_lo + width / 2;
+        if (isfinite(denominator) and denominator > 0)
+            step_wls = step_lo - dphi_lo * width * width / denominator;
+        step_wls = max(min(step_wls, max(step_lo + width / 10, step_hi - width / 10)),
+                       min(step_lo + width / 10, step_hi - width / 10));
+
+        T dphi_step{0};
+        T phi_step{evaluate_phi(step_wls, dphi_step)};
+        if (!isfinite(phi_step) or phi_step > phi_0 + sufficient_para * step_wls * dphi_0 or phi_step >= phi_lo)
+        {
+            step_hi = step_wls;
+            phi_hi = phi_step;
+        }
+        else
+        {
+            if (abs(dphi_step) <= -curvature_para * dphi_0)
+                return step_wls;
+            if (dphi_step * width >= 0)
+            {
+                step_hi = step_lo;
+                phi_hi = phi_lo;
+            }
+            step_lo = step_wls;
+            phi_lo = phi_step;
+            dphi_lo = dphi_step;
+        }
+    }
+
+    // the conditions are not met, fall back to the best step size found
+    T dphi_lo_final{0};
+    evaluate_phi(step_lo, dphi_lo_final);
+    return step_lo;
 }
 
-int Input_Data::newtons_method()
+template <typename T>
+bool Input_Data<T>::reset_inverse_hessian(const vector<T> &x_vec_rih, Solver_Workspace<T> &workspace_rih) const
 {
-    x_current = x_initial;
-    constexpr long double max_norm{1000000000}; // larger norm may result in overflow
+    T max_or_min_rih{static_cast<T>(min_max)};
+    size_t num_of_x_vars{polyn.get_num_of_x_vars()};
+    matrix<T> &hessian_rih{workspace_rih.hessian};
+    polyn.hessian_f(x_vec_rih, hessian_rih, workspace_rih.hessian_scratch);
+    // the hessian of -max_or_min * f, it must be positive definite for the bfgs direction to improve f
+    for (size_t row_idx{0}; row_idx < num_of_x_vars; row_idx++)
+        for (size_t col_idx{0}; col_idx < num_of_x_vars; col_idx++)
+            hessian_rih(row_idx, col_idx) *= -max_or_min_rih;
+    workspace_rih.hessian_factor = hessian_rih; // same size, thus copied without allocating
+    if (!cholesky_factor(workspace_rih.hessian_factor))
+        return false;
+
+    // column k of the inverse solves hessian * column = e_k, the inverse is symmetric, thus it is stored as row k
+    vector<T> &column_rih{workspace_rih.inverse_hessian_product};
+    for (size_t col_idx{0}; col_idx < num_of_x_vars; col_idx++)
+    {
+        fill(column_rih.begin(), column_rih.end(), T{0});
+        column_rih[col_idx] = 1;
+        cholesky_solve(workspace_rih.hessian_factor, column_rih);
+        for (size_t row_idx{0}; row_idx < num_of_x_vars; row_idx++)
+            workspace_rih.inverse_hessian(col_idx, row_idx) = column_rih[row_idx];
+    }
+    return true;
+}
 
-    ofstream store_iters_nm{"output_iterations_newtons_method.txt"};
-    if (!store_iters_nm)
-        throw err_fail_to_read_iter_txt();
+template <typename T>
+bool Input_Data<T>::steihaug_solve(const vector<T> &x_vec_ss, const T &trust_radius, Solver_Workspace<T> &workspace_ss) const
+{
+    T max_or_min_ss{static_cast<T>(min_max)};
+    size_t num_of_x_vars{polyn.get_num_of_x_vars()};
+    vector<T> &step_ss{workspace_ss.direction};
+    vector<T> &residual_ss{workspace_ss.cg_residual};
+    vector<T> &cg_dir_ss{workspace_ss.cg_direction};
+    vector<T> &hessian_dir_ss{workspace_ss.hessian_vector};
 
-    for (size_t curr_iter_nm{0}; curr_iter_nm < max_iter; curr_iter_nm++)
+    // moves the step along cg_dir_ss to the boundary of the trust region, the positive root of
+    // |step + tau * cg_dir|^2 = trust_radius^2, the step is inside the region thus the root exists
+    auto move_to_boundary = [&] {
+        T a_ss{cg_dir_ss * cg_dir_ss};
+        T b_ss{2 * (step_ss * cg_dir_ss)};
+        T c_ss{step_ss * step_ss - trust_radius * trust_radius};
+        T tau_ss{(-b_ss + sqrt(max(T{0}, b_ss * b_ss - 4 * a_ss * c_ss))) / (2 * a_ss)};
+        step_ss += tau_ss * cg_dir_ss;
+    };
+
+    // the residual starts at the gradient of -max_or_min * f, the first direction is its negative
+    fill(step_ss.begin(), step_ss.end(), T{0});
+    residual_ss = workspace_ss.gradient; // same size, thus copied without allocating
+    residual_ss *= -max_or_min_ss;
+    cg_dir_ss = workspace_ss.gradient;
+    cg_dir_ss *= max_or_min_ss;
+    T residual_dot{residual_ss * residual_ss};
+    // stop once the residual is small relative to the gradient, superlinear convergence near the optimum
+    T residual_tol{min(T{0.5}, sqrt(sqrt(residual_dot))) * sqrt(residual_dot)};
+
+    for (size_t inner_iter{0}; inner_iter < num_of_x_vars; inner_iter++)
     {
-        vector<long double> curr_gradient_nm{polyn.gradient_f(x_current)};
-        store_iters_nm << "Iteration " << curr_iter_nm + 1 << ": " << '\n';     // store each iteration
-        store_iters_nm.precision(10);                                           // store each iteration
-        store_iters_nm << "Current_x: " << x_current;                           // store each iteration
-        store_iters_nm << "Gradient: " << curr_gradient_nm;                     // store each iteration
-        store_iters_nm << "Norm: " << euclidean_norm(curr_gradient_nm) << '\n'; // store each iteration
-        // found a local minimum if the norm of the current gradient is with the tolerance
-        if (euclidean_norm(curr_gradient_nm) < tolerance)
+        // another thread requested the algorithm to stop, the step so far is inside the region
+        if (workspace_ss.stop_requested())
+            return false;
+        // hessian of -max_or_min * f times the direction
+        polyn.hessian_vector_f(x_vec_ss, cg_dir_ss, hessian_dir_ss, workspace_ss.hessian_scratch);
+        hessian_dir_ss *= -max_or_min_ss;
+        T curvature_ss{cg_dir_ss * hessian_dir_ss};
+        // the model is not convex along the direction, it decreases all the way to the boundary
+        if (!(curvature_ss > 0))
         {
-            store_iters_nm.close();
-            return 1;
+            move_to_boundary();
+            return true;
         }
-        // larger norm may result in overflow
-        if (euclidean_norm(curr_gradient_nm) > max_norm)
+        T alpha_ss{residual_dot / curvature_ss};
+        T next_norm_squared{step_ss * step_ss + 2 * alpha_ss * (step_ss * cg_dir_ss) +
+                            alpha_ss * alpha_ss * (cg_dir_ss * cg_dir_ss)};
+        if (next_norm_squared >= trust_radius * trust_radius)
         {
-            store_iters_nm.close();
-            return 3;
+            move_to_boundary();
+            return true;
         }
+        step_ss += alpha_ss * cg_dir_ss;
+        residual_ss += alpha_ss * hessian_dir_ss;
+        T next_residual_dot{residual_ss * residual_ss};
+        if (sqrt(next_residual_dot) < residual_tol)
+            return false;
+        cg_dir_ss *= next_residual_dot / residual_dot;
+        cg_dir_ss -= residual_ss;
+        residual_dot = next_residual_dot;
+    }
+    return false;
+}
 
-        size_t x_size{polyn.get_num_of_x_vars()};
-        vector<long double> curr_direction_vec(x_size);
-        matrix<long double> curr_direction_mtx(x_size, 1, curr_gradient_nm);
-        matrix<long double> inverse_hessian(x_size, x_size);
-        inverse_hessian = polyn.inverse_hessian_f(x_current);
-        curr_direction_mtx = -1.0L * inverse_hessian * curr_direction_mtx;
-        for (size_t mtx_to_vec{0}; mtx_to_vec < x_size; mtx_to_vec++)
-        {
-            curr_direction_vec.at(mtx_to_vec) = curr_direction_mtx(mtx_to_vec, 0);
-        }
-        store_iters_nm << "Direction: " << curr_direction_vec; // store each iteration
-        x_current += curr_direction_vec;                       // move to the next x
-        store_iters_nm << "Next_x: " << x_current << '\n';     // store each iteration
-    };
-    store_iters_nm.close();
-    return 2;
-}
\ No newline at end of file
+// ======================================================================
+// Public member functions of Input_Data: evaluate/perform algorithms
+// ======================================================================
+// see Input_Data.hpp for description
+
+template <typename T>
+int Input_Data<T>::gradient_descent()
+{
+    return gradient_descent(x_current, dropped_trace_records);
+}
+
+template <typename T>
+int Input_Data<T>::gradient_descent(vector<T> &x_current_gd, size_t &dropped_gd) const
+{
+    return run_algorithm("gradient_descent", x_current_gd, dropped_gd);
+}
+
+template <typename T>
+int Input_Data<T>::newtons_method()
+{
+    return newtons_method(x_current, dropped_trace_records);
+}
+
+template <typename T>
+int Input_Data<T>::newtons_method(vector<T> &x_current_nm, size_t &dropped_nm) const
+{
+    return run_algorithm("newtons_method", x_current_nm, dropped_nm);
+}
+
+template <typename T>
+int Input_Data<T>::run_algorithm(const string &algorithm_str, vector<T> &x_current_ra, size_t &dropped_ra) const
+{
+    Solver_Workspace<T> workspace_ra(polyn);
+    return run_algorithm(algorithm_str, x_current_ra, dropped_ra, workspace_ra);
+}
+
+template <typename T>
+int Input_Data<T>::run_algorithm(const string &algorithm_str, vector<T> &x_current_ra, size_t &dropped_ra,
+                                 Solver_Workspace<T> &workspace_ra) const
+{
+    // check the name before the trace creates its file
+    if (!is_algorithm_name(algorithm_str))
+        throw err_unknown_algorithm();
+    if (trace_options.format == "none")
+    {
+        Null_Observer observer_ra;
+        dropped_ra = 0;
+        return run_algorithm(algorithm_str, x_initial, x_current_ra, workspace_ra, observer_ra);
+    }
+    Iteration_Trace<T> trace_ra(algorithm_str, trace_options, polyn.get_num_of_x_vars(), min_max);
+    int case_ra{run_algorithm(algorithm_str, x_initial, x_current_ra, workspace_ra, trace_ra)};
+    dropped_ra = trace_ra.finish(); // the last iteration is only stored once the algorithm returns
+    return case_ra;
+}
+
+// ======================================================================
+// Explicit instantiations of Input_Data: evaluate/perform algorithms
+// ======================================================================
+
+template float Input_Data<float>::euclidean_norm(const vector<float> &) const;
+template float Input_Data<float>::backtracking_line_search(const vector<float> &, const float &, const vector<float> &,
+                                                           const vector<float> &, Solver_Workspace<float> &, float &) const;
+template float Input_Data<float>::wolfe_line_search(const vector<float> &, const float &, const vector<float> &,
+                                                    const vector<float> &, const float &, Solver_Workspace<float> &,
+                                                    float &) const;
+template bool Input_Data<float>::reset_inverse_hessian(const vector<float> &, Solver_Workspace<float> &) const;
+template bool Input_Data<float>::steihaug_solve(const vector<float> &, const float &, Solver_Workspace<float> &) const;
+template int Input_Data<float>::gradient_descent();
+template int Input_Data<float>::gradient_descent(vector<float> &, size_t &) const;
+template int Input_Data<float>::newtons_method();
+template int Input_Data<float>::newtons_method(vector<float> &, size_t &) const;
+template int Input_Data<float>::run_algorithm(const string &, vector<float> &, size_t &) const;
+template int Input_Data<float>::run_algorithm(const string &, vector<float> &, size_t &, Solver_Workspace<float> &) const;
+
+template double Input_Data<double>::euclidean_norm(const vector<double> &) const;
+template double Input_Data<double>::backtracking_line_search(const vector<double> &, const double &, const vector<double> &,
+                                                             const vector<double> &, Solver_Workspace<double> &, double &) const;
+template double Input_Data<double>::wolfe_line_search(const vector<double> &, const double &, const vector<double> &,
+                                                      const vector<double> &, const double &, Solver_Workspace<double> &,
+                                                      double &) const;
+template bool Input_Data<double>::reset_inverse_hessian(const vector<double> &, Solver_Workspace<double> &) const;
+template bool Input_Data<double>::steihaug_solve(const vector<double> &, const double &, Solver_Workspace<double> &) const;
+template int Input_Data<double>::gradient_descent();
+template int Input_Data<double>::gradient_descent(vector<double> &, size_t &) const;
+template int Input_Data<double>::newtons_method();
+template int Input_Data<double>::newtons_method(vector<double> &, size_t &) const;
+template int Input_Data<double>::run_algorithm(const string &, vector<double> &, size_t &) const;
+template int Input_Data<double>::run_algorithm(const string &, vector<double> &, size_t &, Solver_Workspace<double> &) const;
+
+template long double Input_Data<long double>::euclidean_norm(const vector<long double> &) const;
+template long double Input_Data<long double>::backtracking_line_search(const vector<long double> &, const long double &, const vector<long double> &,
+                                                                       const vector<long double> &, Solver_Workspace<long double> &, long double &) const;
+template long double Input_Data<long double>::wolfe_line_search(const vector<long double> &, const long double &,
+                                                                const vector<long double> &,
+                                                                const vector<long double> &, const long double &,
+                                                                Solver_Workspace<long double> &, long double &) const;
+template bool Input_Data<long double>::reset_inverse_hessian(const vector<long double> &, Solver_Workspace<long double> &) const;
+template bool Input_Data<long double>::steihaug_solve(const vector<long double> &, const long double &, Solver_Workspace<long double> &) const;
+template int Input_Data<long double>::gradient_descent();
+template int Input_Data<long double>::gradient_descent(vector<long double> &, size_t &) const;
+template int Input_Data<long double>::newtons_method();
+template int Input_Data<long double>::newtons_method(vector<long double> &, size_t &) const;
+template int Input_Data<long double>::run_algorithm(const string &, vector<long double> &, size_t &) const;
+template int Input_Data<long double>::run_algorithm(const string &, vector<long double> &, size_t &, Solver_Workspace<long double> &) const;
@@ -14,7 +14,8 @@ using namespace std;
 // ======================================================================
 // see Input_Data.hpp for description
 
-Input_Data::Input_Data(const string &filename)
+template <typename T>
+Input_Data<T>::Input_Data(const string &filename)
     : polyn("f(x_1)=0") //initialize a Polynomial
 {
     check_valid_file(filename);
@@ -25,57 +26,116 @@ Input_Data::Input_Data(const string &filename)
     check_valid_fifth_line();
 }
 
-int Input_Data::get_min_max() const
+template <typename T>
+Input_Data<T>::Input_Data(const vector<string> &input_lines)
+    : polyn("f(x_1)=0") //initialize a Polynomial
+{
+    check_valid_lines(input_lines);
+    check_valid_first_line();
+    check_valid_second_line();
+    check_valid_third_line();
+    check_valid_fourth_line();
+    check_valid_fifth_line();
+}
+
+template <typename T>
+int Input_Data<T>::get_min_max() const
 {
     return min_max;
 }
 
-Polynomial Input_Data::get_polynomial() const
+template <typename T>
+Polynomial<T> Input_Data<T>::get_polynomial() const
 {
     return polyn;
 }
 
-vector<long double> Input_Data::get_x_initial() const
+template <typename T>
+vector<T> Input_Data<T>::get_x_initial() const
 {
     return x_initial;
 }
 
-vector<long double> Input_Data::get_x_current() const
+template <typename T>
+vector<T> Input_Data<T>::get_x_current() const
 {
     return x_current;
 }
 
-long double Input_Data::get_tolerance() const
+template <typename T>
+T Input_Data<T>::get_tolerance() const
 {
     return tolerance;
 }
 
-size_t Input_Data::get_max_iter() const
+template <typename T>
+size_t Input_Data<T>::get_max_iter() const
 {
     return max_iter;
 }
 
+template <typename T>
+size_t Input_Data<T>::get_dropped_trace_records() const
+{
+    return dropped_trace_records;
+}
+
+template <typename T>
+Algorithm_Options Input_Data<T>::get_algorithm_options() const
+{
+    return algorithm_options;
+}
+
+// ======================================================================
+// Public member functions of Input_Data: set options
+// ======================================================================
+// see Input_Data.hpp for description
+
+template <typename T>
+void Input_Data<T>::set_trace_options(const Trace_Options &input_trace_options)
+{
+    trace_options = input_trace_options;
+}
+
+template <typename T>
+void Input_Data<T>::set_algorithm_options(const Algorithm_Options &input_algorithm_options)
+{
+    algorithm_options = input_algorithm_options;
+}
+
 // ======================================================================
 // Private member functions of Input_Data: validate input data
 // ======================================================================
 // see Input_Data.hpp for description
 
-void Input_Data::remove_spaces(string &str_to_remove)
+template <typename T>
+void Input_Data<T>::remove_spaces(string &str_to_remove)
 {
     str_to_remove.erase(remove_if(str_to_remove.begin(), str_to_remove.end(),
                                   [](const char &c) { return c == ' '; }),
                         str_to_remove.end());
 }
 
-void Input_Data::check_valid_file(const string &filename_cvf)
+template <typename T>
+void Input_Data<T>::check_valid_file(const string &filename_cvf)
 {
     ifstream input_file{filename_cvf};
     if (!input_file)
         throw err_fail_to_read_func_txt();
 
-    size_t input_line_idx{0}; // input line index starts from 0
-    string input_str{""};     // used for getline
+    vector<string> input_lines;
+    string input_str{""}; // used for getline
     while (getline(input_file, input_str))
+        input_lines.push_back(input_str);
+    input_file.close();
+    check_valid_lines(input_lines);
+}
+
+template <typename T>
+void Input_Data<T>::check_valid_lines(const vector<string> &lines_cvl)
+{
+    size_t input_line_idx{0}; // input line index starts from 0
+    for (string input_str : lines_cvl)
     {
         remove_spaces(input_str); // remove spaces first
         // now store each input line to the corresponding line_str
@@ -92,13 +152,9 @@ void Input_Data::check_valid_file(const string &filename_cvf)
         else if (input_str == "") // newline at end of file
             continue;
         else if (input_line_idx > 4)
-        {
-            input_file.close();
             throw err_more_than_5_lines();
-        }
         input_line_idx++;
     }
-    input_file.close();
 
     // if any of the 5 lines are empty, invalid input
     if (first_line_str == "" or second_line_str == "" or third_line_str == "" or
@@ -106,7 +162,8 @@ void Input_Data::check_valid_file(const string &filename_cvf)
         throw err_less_than_5_lines();
 }
 
-void Input_Data::check_valid_first_line()
+template <typename T>
+void Input_Data<T>::check_valid_first_line()
 {
     // check valid first line
     if (first_line_str == "min")
@@ -117,15 +174,17 @@ void Input_Data::check_valid_first_line()
         throw err_invalid_first_line();
 }
 
-void Input_Data::check_valid_second_line()
+template <typename T>
+void Input_Data<T>::check_valid_second_line()
 {
     // check valid second line
 
-    Polynomial temp_poly(second_line_str);
+    Polynomial<T> temp_poly(second_line_str);
     polyn = temp_poly;
 }
 
-void Input_Data::check_valid_third_line()
+template <typename T>
+void Input_Data<T>::check_valid_third_line()
 {
     // check valid third line
     if (third_line_str.substr(0, 14) == "initial_point=")
@@ -137,7 +196,7 @@ void Input_Data::check_valid_third_line()
         {
             try
             {
-                long double initial_x_value{stold(curr_x_var_stream)};
+                T initial_x_value{static_cast<T>(stold(curr_x_var_stream))};
                 x_initial.push_back(initial_x_value);
             }
             catch (const std::invalid_argument &e)
@@ -152,14 +211,15 @@ void Input_Data::check_valid_third_line()
         throw err_invalid_third_line();
 }
 
-void Input_Data::check_valid_fourth_line()
+template <typename T>
+void Input_Data<T>::check_valid_fourth_line()
 {
     // check valid fourth line
     if (fourth_line_str.substr(0, 10) == "tolerance=")
     {
         try
         {
-            tolerance = stod(fourth_line_str.substr(10, fourth_line_str.size() - 10));
+            tolerance = static_cast<T>(stold(fourth_line_str.substr(10, fourth_line_str.size() - 10)));
         }
         catch (const std::invalid_argument &e)
         {
@@ -172,7 +232,8 @@ void Input_Data::check_valid_fourth_line()
         throw err_invalid_fourth_line();
 }
 
-void Input_Data::check_valid_fifth_line()
+template <typename T>
+void Input_Data<T>::check_valid_fifth_line()
 {
     // check valid fifth line
     if (fifth_line_str.substr(0, 9) == "max_iter=")
@@ -191,3 +252,46 @@ void Input_Data::check_valid_fifth_line()
     else
         throw err_invalid_fifth_line();
 }
+
+// ======================================================================
+// Explicit instantiations of Input_Data: validate input data
+// ======================================================================
+
+template Input_Data<float>::Input_Data(const string &);
+template Input_Data<float>::Input_Data(const vector<string> &);
+template int Input_Data<float>::get_min_max() const;
+template Polynomial<float> Input_Data<float>::get_polynomial() const;
+template vector<float> Input_Data<float>::get_x_initial() const;
+template vector<float> Input_Data<float>::get_x_current() const;
+template float Input_Data<float>::get_tolerance() const;
+template size_t Input_Data<float>::get_max_iter() const;
+template size_t Input_Data<float>::get_dropped_trace_records() const;
+template Algorithm_Options Input_Data<float>::get_algorithm_options() const;
+template void Input_Data<float>::set_trace_options(const Trace_Options &);
+template void Input_Data<float>::set_algorithm_options(const Algorithm_Options &);
+
+template Input_Data<double>::Input_Data(const string &);
+template Input_Data<double>::Input_Data(const vector<string> &);
+template int Input_Data<double>::get_min_max() const;
+template Polynomial<double> Input_Data<double>::get_polynomial() const;
+template vector<double> Input_Data<double>::get_x_initial() const;
+template vector<double> Input_Data<double>::get_x_current() const;
+template double Input_Data<double>::get_tolerance() const;
+template size_t Input_Data<double>::get_max_iter() const;
+template size_t Input_Data<double>::get_dropped_trace_records() const;
+template Algorithm_Options Input_Data<double>::get_algorithm_options() const;
+template void Input_Data<double>::set_trace_options(const Trace_Options &);
+template void Input_Data<double>::set_algorithm_options(const Algorithm_Options &);
+
+template Input_Data<long double>::Input_Data(const string &);
+template Input_Data<long double>::Input_Data(const vector<string> &);
+template int Input_Data<long double>::get_min_max() const;
+template Polynomial<long double> Input_Data<long double>::get_polynomial() const;
+template vector<long double> Input_Data<long double>::get_x_initial() const;
+template vector<long double> Input_Data<long double>::get_x_current() const;
+template long double Input_Data<long double>::get_tolerance() const;
+template size_t Input_Data<long double>::get_max_iter() const;
+template size_t Input_Data<long double>::get_dropped_trace_records() const;
+template Algorithm_Options Input_Data<long double>::get_algorithm_options() const;
+template void Input_Data<long double>::set_trace_options(const Trace_Options &);
+template void Input_Data<long double>::set_algorithm_options(const Algorithm_Options &);
@@ -0,0 +1,412 @@
+/**
+ * @file Iteration_Trace.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief An Iteration_Trace class that stores the iterations of an optimization algorithm
+ *
+ * @details This library contains a class Iteration_Trace, the observer (see Observer.hpp) used by
+ * the optimization algorithms of Input_Data to store their iterations to
+ * output_iterations_<algorithm>.bin (binary format) or output_iterations_<algorithm>.txt (text format). <br>
+ * Only every k-th iteration is stored (k is the stride), together with the first iteration,
+ * the last iteration and any anomaly (a non-finite value, or f moving away from the optimum). <br>
+ * The optimization thread only copies the raw values of an iteration into a Ring_Buffer,
+ * a writer thread formats them and writes them to the file. If the ring buffer is full,
+ * the optimization thread either waits for the writer thread (backpressure) or drops the record,
+ * records of the first iteration, the last iteration and anomalies are never dropped.
+ * The slots of the ring buffer are allocated up front, thus their number is capped so that
+ * they take at most trace_buffer_bytes, whatever the number of x variables. <br>
+ * The binary format is a header followed by fixed-width records of doubles, one column per field:
+ * - header: trace_magic (8 chars), trace_version, the algorithm name (trace_algorithm_size chars,
+ *   zero padded), the number of x variables n and the stride, all integers are uint64_t
+ * - record: iteration, flags, f, norm, step, x (n values), gradient (n values), next_x (n values) <br>
+ * The last iteration does not move to a next x, its step and next_x are nan.
+ * tools/trace_to_text.cpp converts a binary trace to the text format
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Ring_Buffer.hpp"
+#include "vector_overloads.hpp"
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+// ======================================================================
+// Binary trace format
+// ======================================================================
+
+constexpr char trace_magic[8]{'P', 'O', 'L', 'Y', 'T', 'R', 'C', '\0'}; // first 8 bytes of a binary trace
+constexpr uint64_t trace_version{1};                                  // version of the binary format
+constexpr size_t trace_algorithm_size{32};                            // size of the algorithm name field
+
+// memory budget of the ring buffer of an Iteration_Trace, its slots are allocated up front
+constexpr size_t trace_buffer_bytes{16 * 1024 * 1024};
+
+// flags of a record, stored in the second column as a double
+constexpr unsigned int trace_flag_first{1};    // first iteration
+constexpr unsigned int trace_flag_last{2};     // last iteration
+constexpr unsigned int trace_flag_anomaly{4};  // non-finite value, or f moved away from the optimum
+constexpr unsigned int trace_flag_has_next{8}; // the iteration moved to a next x (step and next_x are valid)
+
+// number of doubles in a record for n x variables
+inline size_t trace_record_size(const size_t &num_of_x_vars)
+{
+    return 5 + 3 * num_of_x_vars;
+}
+
+/**
+ * @brief A struct for the options of an Iteration_Trace
+ */
+struct Trace_Options
+{
+    string format{"binary"};     // "binary", "text" or "none" (the iterations are not stored)
+    size_t stride{1};            // store every stride-th iteration
+    size_t buffer_size{4096};    // maximum number of records the ring buffer holds, see trace_buffer_slots
+    bool drop_when_full{false};  // drop records when the ring buffer is full instead of waiting
+};
+
+/**
+ * @brief A struct for the raw values of an iteration, a slot of the ring buffer of Iteration_Trace
+ * @tparam T The scalar type of the algorithm
+ */
+template <typename T>
+struct Trace_Record
+{
+    size_t iteration{0};    // 1-based index of the iteration
+    unsigned int flags{0};  // trace_flag_* values
+    T f{0};                 // f at the current x
+    T norm{0};              // norm of the gradient
+    T step{0};              // step size, x moves to x + step * direction
+    vector<T> x;            // current x
+    vector<T> gradient;     // gradient at the current x
+    vector<T> direction;    // search direction
+};
+
+/**
+ * @brief Function used to obtain the number of slots of the ring buffer of an Iteration_Trace
+ * @tparam T The scalar type of the algorithm
+ * @param buffer_size The maximum number of records, see Trace_Options
+ * @param num_of_x_vars The number of x variables, each record holds 3 vectors of this size
+ * @return size_t buffer_size, or fewer slots (at least 1) if buffer_size slots take more than trace_buffer_bytes
+ */
+template <typename T>
+size_t trace_buffer_slots(const size_t &buffer_size, const size_t &num_of_x_vars)
+{
+    size_t slot_bytes{sizeof(Trace_Record<T>) + 3 * num_of_x_vars * sizeof(T)};
+    return max(size_t{1}, min(buffer_size, trace_buffer_bytes / slot_bytes));
+}
+
+/**
+ * @brief A class for the iteration trace of an optimization algorithm
+ * @tparam T The scalar type of the algorithm
+ */
+template <typename T>
+class Iteration_Trace
+{
+public:
+    static constexpr bool observes_iterations{true};
+    static constexpr bool can_stop{false};
+
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Iteration_Trace object, open its output file and start the writer thread
+     * @param input_algorithm_str The name of the algorithm, used for the file name and the text layout
+     * @param input_options The format, stride, ring buffer size and full buffer policy
+     * @param input_num_of_x_vars The number of x variables of the polynomial
+     * @param input_min_max 1 if f is maximized, -1 if f is minimized, used to detect anomalies
+     * @throws err_fail_to_read_iter_txt if the program fails to open the output file
+     */
+    Iteration_Trace(const string &input_algorithm_str, const Trace_Options &input_options,
+                    const size_t &input_num_of_x_vars, const int &input_min_max)
+        : algorithm_str(input_algorithm_str), binary(input_options.format == "binary"),
+          stride(input_options.stride == 0 ? 1 : input_options.stride),
+          drop_when_full(input_options.drop_when_full), num_of_x_vars(input_num_of_x_vars),
+          min_max(input_min_max), pending(make_record(input_num_of_x_vars)),
+          ring(trace_buffer_slots<T>(input_options.buffer_size, input_num_of_x_vars), pending), next_x(input_num_of_x_vars),
+          binary_record(trace_record_size(input_num_of_x_vars))
+    {
+        string filename{"output_iterations_" + algorithm_str + (binary ? ".bin" : ".txt")};
+        store_iters.open(filename, binary ? ios::binary : ios::out);
+        if (!store_iters)
+            throw err_fail_to_read_iter_txt();
+        if (binary)
+        {
+            char algorithm_field[trace_algorithm_size]{};
+            algorithm_str.copy(algorithm_field, trace_algorithm_size - 1);
+            uint64_t num_of_x_vars_field{num_of_x_vars};
+            uint64_t stride_field{stride};
+            store_iters.write(trace_magic, sizeof(trace_magic));
+            store_iters.write(reinterpret_cast<const char *>(&trace_version), sizeof(trace_version));
+            store_iters.write(algorithm_field, trace_algorithm_size);
+            store_iters.write(reinterpret_cast<const char *>(&num_of_x_vars_field), sizeof(num_of_x_vars_field));
+            store_iters.write(reinterpret_cast<const char *>(&stride_field), sizeof(stride_field));
+        }
+        else
+            store_iters.precision(10);
+        writer = thread(&Iteration_Trace::write_records, this);
+    }
+
+    /**
+     * @brief Destroy the Iteration_Trace object, the pending iteration is stored as the last iteration
+     */
+    ~Iteration_Trace()
+    {
+        finish();
+    }
+
+    Iteration_Trace(const Iteration_Trace &) = delete;
+    Iteration_Trace &operator=(const Iteration_Trace &) = delete;
+
+    // ======================================================================
+    // Public member functions of Iteration_Trace: store iterations
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to start a new iteration at the current x,
+     * the previous iteration is passed to the writer thread if it is selected by the stride
+     * @param input_iteration The 1-based index of the iteration
+     * @param input_x The current x values
+     * @param input_f The value of f at the current x
+     * @param input_gradient The gradient at the current x
+     * @param input_norm The euclidean norm of the gradient
+     */
+    void begin_iteration(const size_t &input_iteration, const vector<T> &input_x, const T &input_f,
+                         const vector<T> &input_gradient, const T &input_norm)
+    {
+        if (has_pending)
+            push_pending(false);
+        pending.flags = (input_iteration == 1) ? trace_flag_first : 0;
+        if (!isfinite(input_f) or !isfinite(input_norm))
+            pending.flags |= trace_flag_anomaly;
+        // f should not move away from the optimum, (f - previous f) has the sign of min_max
+        else if (has_previous_f and (input_f - previous_f) * static_cast<T>(min_max) < 0)
+            pending.flags |= trace_flag_anomaly;
+        pending.iteration = input_iteration;
+        pending.x = input_x; // same size, thus copied without allocating
+        pending.f = input_f;
+        pending.gradient = input_gradient;
+        pending.norm = input_norm;
+        previous_f = input_f;
+        has_previous_f = true;
+        has_pending = true;
+    }
+
+    /**
+     * @brief Public member function used to end the current iteration, which moves to x + step * direction
+     * @param input_step The step size
+     * @param input_direction The search direction
+     */
+    void end_iteration(const T &input_step, const vector<T> &input_direction)
+    {
+        pending.step = input_step;
+        pending.direction = input_direction;
+        pending.flags |= trace_flag_has_next;
+        if (!isfinite(input_step))
+            pending.flags |= trace_flag_anomaly;
+    }
+
+    /**
+     * @brief Public member function used to store the pending iteration as the last iteration,
+     * wait for the writer thread to store all records and close the file
+     * @return size_t The number of records dropped because the ring buffer was full
+     */
+    size_t finish()
+    {
+        if (has_pending)
+            push_pending(true);
+        if (writer.joinable())
+        {
+            closing.store(true, memory_order_release);
+            writer.join();
+        }
+        if (store_iters.is_open())
+            store_iters.close();
+        return dropped_records;
+    }
+
+private:
+    // ======================================================================
+    // Private data of Iteration_Trace
+    // ======================================================================
+
+    string algorithm_str; // name of the algorithm
+    bool binary;          // binary or text format
+    size_t stride;        // store every stride-th iteration
+    bool drop_when_full;  // drop records when the ring buffer is full instead of waiting
+    size_t num_of_x_vars; // number of x variables of the polynomial
+    int min_max;          // 1 represents maximum, -1 represents minimum
+
+    // data of the optimization thread
+    // the current iteration is pushed once the next iteration begins (or the algorithm finishes)
+    // since only then it is known whether it is the last iteration
+    Trace_Record<T> pending;
+    bool has_pending{false};
+    T previous_f{0};            // f of the previous iteration, used to detect anomalies
+    bool has_previous_f{false};
+    size_t dropped_records{0};  // records dropped because the ring buffer was full
+
+    // data shared by the two threads
+    Ring_Buffer<Trace_Record<T>> ring;
+    atomic<bool> closing{false}; // set once the last record is pushed
+
+    // data of the writer thread
+    ofstream store_iters;          // output file
+    vector<T> next_x;              // buffer of x + step * direction
+    vector<double> binary_record;  // buffer of a binary record
+    thread writer;
+
+    // ======================================================================
+    // Private member functions of Iteration_Trace: optimization thread
+    // ======================================================================
+
+    /**
+     * @brief Private member function used to create a record with vectors of the given size
+     * @param num_of_x_vars_mr The number of x variables
+     * @return Trace_Record<T> The record
+     */
+    static Trace_Record<T> make_record(const size_t &num_of_x_vars_mr)
+    {
+        Trace_Record<T> record_mr;
+        record_mr.x.resize(num_of_x_vars_mr);
+        record_mr.gradient.resize(num_of_x_vars_mr);
+        record_mr.direction.resize(num_of_x_vars_mr);
+        return record_mr;
+    }
+
+    /**
+     * @brief Private member function used to pass the pending iteration to the writer thread if it is selected
+     * @param last true if the pending iteration is the last iteration of the algorithm
+     */
+    void push_pending(const bool &last)
+    {
+        has_pending = false;
+        if (last)
+            pending.flags |= trace_flag_last;
+        bool essential{(pending.flags & (trace_flag_first | trace_flag_last | trace_flag_anomaly)) != 0};
+        if (!essential and (pending.iteration - 1) % stride != 0)
+            return;
+
+        Trace_Record<T> *slot{ring.try_acquire()};
+        while (slot == nullptr)
+        {
+            if (drop_when_full and !essential)
+            {
+                dropped_records++;
+                return;
+            }
+            // backpressure: wait for the writer thread to free a slot
+            this_thread::yield();
+            slot = ring.try_acquire();
+        }
+        *slot = pending; // same sizes, thus copied without allocating
+        ring.publish();
+    }
+
+    // ======================================================================
+    // Private member functions of Iteration_Trace: writer thread
+    // ======================================================================
+
+    /**
+     * @brief Private member function run by the writer thread, stores the records until finish is called
+     */
+    void write_records()
+    {
+        size_t idle_polls{0};
+        while (true)
+        {
+            const Trace_Record<T> *record_wr{ring.front()};
+            if (record_wr != nullptr)
+            {
+                if (binary)
+                    store_binary(*record_wr);
+                else
+                    store_text(*record_wr);
+                ring.pop();
+                idle_polls = 0;
+                continue;
+            }
+            // every record is pushed before closing is set, so check the ring buffer once more
+            if (closing.load(memory_order_acquire))
+            {
+                if (ring.front() == nullptr)
+                    break;
+                continue;
+            }
+            // the optimization thread is busy, poll again soon without spinning on a core
+            if (++idle_polls < 64)
+                this_thread::yield();
+            else
+                this_thread::sleep_for(chrono::microseconds(100));
+        }
+        store_iters.flush();
+    }
+
+    /**
+     * @brief Private member function used to compute x + step * direction of a record
+     * @param record_nx The record
+     */
+    void compute_next_x(const Trace_Record<T> &record_nx)
+    {
+        next_x = record_nx.x; // same size, thus copied without allocating
+        next_x += record_nx.step * record_nx.direction;
+    }
+
+    /**
+     * @brief Private member function used to store a record in binary format
+     * @param record_sb The record
+     */
+    void store_binary(const Trace_Record<T> &record_sb)
+    {
+        const double nan_value{numeric_limits<double>::quiet_NaN()};
+        bool has_next{(record_sb.flags & trace_flag_has_next) != 0};
+        if (has_next)
+            compute_next_x(record_sb);
+        binary_record[0] = static_cast<double>(record_sb.iteration);
+        binary_record[1] = static_cast<double>(record_sb.flags);
+        binary_record[2] = static_cast<double>(record_sb.f);
+        binary_record[3] = static_cast<double>(record_sb.norm);
+        binary_record[4] = has_next ? static_cast<double>(record_sb.step) : nan_value;
+        for (size_t x_idx{0}; x_idx < num_of_x_vars; x_idx++)
+        {
+            binary_record[5 + x_idx] = static_cast<double>(record_sb.x[x_idx]);
+            binary_record[5 + num_of_x_vars + x_idx] = static_cast<double>(record_sb.gradient[x_idx]);
+            binary_record[5 + 2 * num_of_x_vars + x_idx] = has_next ? static_cast<double>(next_x[x_idx]) : nan_value;
+        }
+        store_iters.write(reinterpret_cast<const char *>(binary_record.data()), binary_record.size() * sizeof(double));
+    }
+
+    /**
+     * @brief Private member function used to store a record in the text layout
+     * @param record_st The record
+     */
+    void store_text(const Trace_Record<T> &record_st)
+    {
+        store_iters << "Iteration " << record_st.iteration << ": " << '\n';
+        store_iters << "Current_x: " << record_st.x;
+        store_iters << "Gradient: " << record_st.gradient;
+        store_iters << "Norm: " << record_st.norm << '\n';
+        if ((record_st.flags & trace_flag_has_next) == 0)
+            return;
+        compute_next_x(record_st);
+        if (algorithm_str == "newtons_method")
+            store_iters << "Direction: " << record_st.direction;
+        else
+            store_iters << "Step_size: " << record_st.step << '\n';
+        store_iters << "Next_x: " << next_x << '\n';
+    }
+};
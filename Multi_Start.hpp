@@ -0,0 +1,346 @@
+/**
+ * @file Multi_Start.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A Multi_Start class that runs the optimization algorithms from many initial points in parallel
+ *
+ * @details This library contains a class Multi_Start that takes an Input_Data and runs one or more of
+ * its optimization algorithms from many initial points, read from a starts file or sampled in a box
+ * (see Start_Sampling.hpp), instead of the single initial_point of input_function.txt. <br>
+ * Every (initial point, algorithm) run is a task of a Thread_Pool (see Thread_Pool.hpp). The Input_Data
+ * and its Polynomial are shared read-only by all tasks, each worker owns a Solver_Workspace,
+ * and each task writes its result to its own slot, thus the runs do not need any locking. <br>
+ * Optionally, f and the gradient are evaluated at all initial points together (see Point_Batch.hpp)
+ * and only the initial points with the best f are kept. <br>
+ * The converged runs are then merged into the distinct stationary points, sorted by f
+ * (ascending for a minimization, descending for a maximization), and stored to a text file
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Algorithm_Options.hpp"
+#include "Input_Data.hpp"
+#include "Observer.hpp"
+#include "Point_Batch.hpp"
+#include "Solver_Workspace.hpp"
+#include "Start_Sampling.hpp"
+#include "Thread_Pool.hpp"
+#include "vector_overloads.hpp"
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+/**
+ * @brief A struct for the options of a multi-start optimization
+ */
+struct Multi_Start_Options
+{
+    string starts_file{""};         // file of initial points, if empty the points are sampled
+    string sampling{"sobol"};       // "sobol" or "lhs" (Latin hypercube)
+    size_t num_of_starts{16};       // number of sampled initial points
+    long double box_lower{-10};     // lower bound of every x variable of the sampled points
+    long double box_upper{10};      // upper bound of every x variable of the sampled points
+    uint64_t seed{1};               // seed of the Latin hypercube sampling
+    size_t num_of_screened_starts{0}; // number of initial points with the best f that are kept, 0 keeps all
+    vector<string> algorithms{"gradient_descent", "newtons_method"}; // algorithms run from every point
+};
+
+/**
+ * @brief A struct for a stationary point found by a multi-start optimization
+ * @tparam T The scalar type of the point
+ */
+template <typename T>
+struct Stationary_Point
+{
+    vector<T> x;               // the point, from the first converged run that reached it
+    T f;                       // the value of the polynomial at x
+    vector<size_t> num_of_runs; // number of converged runs of each algorithm that reached it
+};
+
+/**
+ * @brief A class for a multi-start optimization
+ * @tparam T The scalar type of the Input_Data
+ */
+template <typename T>
+class Multi_Start
+{
+public:
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Multi_Start object, run the algorithms from every initial point
+     * and merge the results into the distinct stationary points
+     * @param input An Input_Data class that stores the input data from input_function.txt,
+     * its initial_point is not used
+     * @param input_options The options of the multi-start optimization
+     * @param num_of_threads The number of worker threads, 0 uses the number of hardware threads
+     * @throws err_invalid_starts_file if the starts file is invalid
+     * @throws err_sobol_too_many_dims if the Sobol sequence does not support the number of x variables
+     * @throws err_unknown_algorithm if an algorithm is not one of algorithm_names (see Algorithm_Options.hpp)
+     */
+    Multi_Start(const Input_Data<T> &input, const Multi_Start_Options &input_options, const size_t &num_of_threads)
+        : input_ms(input), options(input_options), polyn_ms(input.get_polynomial())
+    {
+        for (const string &algorithm_str : options.algorithms)
+            if (!is_algorithm_name(algorithm_str))
+                throw err_unknown_algorithm();
+
+        size_t num_of_x_vars{polyn_ms.get_num_of_x_vars()};
+        T lower_ms{static_cast<T>(options.box_lower)};
+        T upper_ms{static_cast<T>(options.box_upper)};
+        if (!options.starts_file.empty())
+            starts = read_starts_file<T>(options.starts_file, num_of_x_vars);
+        else if (options.sampling == "lhs")
+            starts = latin_hypercube_starts<T>(options.num_of_starts, num_of_x_vars, lower_ms, upper_ms, options.seed);
+        else
+            starts = sobol_starts<T>(options.num_of_starts, num_of_x_vars, lower_ms, upper_ms);
+        num_of_candidate_starts = starts.size();
+        if (options.num_of_screened_starts != 0)
+            screen_starts();
+
+        // time the runs
+        chrono::time_point start_time{chrono::steady_clock::now()};
+        run_all(num_of_threads);
+        chrono::time_point end_time{chrono::steady_clock::now()};
+        elapsed_time_seconds = end_time - start_time;
+
+        merge_stationary_points();
+    }
+
+    // ======================================================================
+    // Public member functions of Multi_Start: get and store results
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the distinct stationary points
+     * @return vector<Stationary_Point<T>> The stationary points sorted by f, the best one first
+     */
+    vector<Stationary_Point<T>> get_stationary_points() const
+    {
+        return stationary_points;
+    }
+
+    /**
+     * @brief Public member function used to store the results to a text file
+     * @param filename The name of the text file
+     * @throws err_fail_to_read_results_txt if the program fails to open the output file
+     */
+    void store_results(const string &filename) const
+    {
+        ofstream store_results{filename};
+        if (!store_results)
+            throw err_fail_to_read_results_txt();
+
+        store_results << "========== Multi-Start Results =========="
+                      << "\n\n";
+        store_results << "min/max: " << input_ms.get_min_max() << '\n';
+        store_results << polyn_ms << '\n';
+        if (!options.starts_file.empty())
+            store_results << "starts_file: " << options.starts_file << '\n';
+        else
+            store_results << "sampling: " << options.sampling << " in [" << options.box_lower << ", "
+                          << options.box_upper << "]" << '\n';
+        store_results << "initial points: " << starts.size();
+        if (options.num_of_screened_starts != 0)
+            store_results << " (the best f of " << num_of_candidate_starts << " screened points)";
+        store_results << '\n';
+        store_results << "tolerance: " << input_ms.get_tolerance() << '\n';
+        store_results << "max_iter: " << input_ms.get_max_iter() << '\n';
+        store_results << "threads: " << num_of_threads_used << "\n\n";
+
+        store_results << "The runs took " << elapsed_time_seconds.count() << " seconds"
+                      << "\n\n";
+
+        // number of runs that ended in each case, see Result_Handling.hpp for the cases
+        for (size_t alg_idx{0}; alg_idx < options.algorithms.size(); alg_idx++)
+        {
+            store_results << options.algorithms[alg_idx] << ":";
+            for (size_t case_idx{1}; case_idx <= 6; case_idx++)
+                if (case_idx != 5) // only the race mode stops its algorithms
+                    store_results << " case " << case_idx << ": " << case_counts[alg_idx][case_idx];
+            store_results << '\n';
+        }
+        store_results << '\n';
+
+        store_results << "Found " << stationary_points.size() << " distinct stationary point(s), sorted by f "
+                      << (input_ms.get_min_max() == 1 ? "(descending)" : "(ascending)") << ":" << '\n';
+        for (size_t point_idx{0}; point_idx < stationary_points.size(); point_idx++)
+        {
+            const Stationary_Point<T> &point{stationary_points[point_idx]};
+            // to improve readability, round the values of the point to 3 decimal places
+            vector<T> x_round_3{point.x};
+            for_each(x_round_3.begin(), x_round_3.end(),
+                     [](T &n) { n = round(n * 1000) / 1000; });
+            store_results << point_idx + 1 << ": f = " << point.f << ", reached by";
+            for (size_t alg_idx{0}; alg_idx < options.algorithms.size(); alg_idx++)
+                store_results << " " << options.algorithms[alg_idx] << " x" << point.num_of_runs[alg_idx];
+            store_results << '\n';
+            store_results << "   x = " << x_round_3;
+        }
+        store_results.close();
+    }
+
+private:
+    // ======================================================================
+    // Private data of Multi_Start
+    // ======================================================================
+
+    /**
+     * @brief A struct for the result of one (initial point, algorithm) run
+     */
+    struct Run_Result
+    {
+        vector<T> x_final; // the current x when the algorithm stopped
+        int case_num{0};   // the case returned by the algorithm, see Result_Handling.hpp
+    };
+
+    const Input_Data<T> &input_ms;                     // shared read-only by all runs
+    Multi_Start_Options options;                      // the options of the multi-start optimization
+    Polynomial<T> polyn_ms;                           // used to size the workspaces and to evaluate f
+    vector<vector<T>> starts;                         // the initial points
+    size_t num_of_candidate_starts{0};                // number of initial points before the screening
+    vector<Run_Result> runs;                          // one result per (initial point, algorithm)
+    vector<Stationary_Point<T>> stationary_points;    // the distinct stationary points, sorted by f
+    vector<vector<size_t>> case_counts;               // number of runs of each algorithm ending in each case
+    size_t num_of_threads_used{0};                    // number of worker threads of the pool
+    chrono::duration<double> elapsed_time_seconds{0}; // wall time of all runs
+
+    // ======================================================================
+    // Private member functions of Multi_Start: run and merge
+    // ======================================================================
+
+    /**
+     * @brief Private member function used to keep only the options.num_of_screened_starts initial points
+     * with the best f, in the order of their f. f and the gradient of all initial points are evaluated
+     * together in double precision, the points where f or the norm of the gradient is not finite or
+     * larger than 1e9 are dropped, since every algorithm would stop there with case 3
+     */
+    void screen_starts()
+    {
+        const double max_norm_ss{1000000000};
+        size_t num_of_x_vars{polyn_ms.get_num_of_x_vars()};
+        Point_Batch points_ss(num_of_x_vars, starts.size());
+        Point_Batch gradients_ss(num_of_x_vars, starts.size());
+        for (size_t start_idx{0}; start_idx < starts.size(); start_idx++)
+            points_ss.set_point(start_idx, starts[start_idx]);
+        vector<double> f_ss;
+        polyn_ms.eval_f_batch(points_ss, f_ss);
+        polyn_ms.gradient_f_batch(points_ss, gradients_ss);
+
+        vector<size_t> kept_idx_ss;
+        for (size_t start_idx{0}; start_idx < starts.size(); start_idx++)
+        {
+            double norm_squared_ss{0};
+            for (size_t x_idx{0}; x_idx < num_of_x_vars; x_idx++)
+                norm_squared_ss += gradients_ss(x_idx, start_idx) * gradients_ss(x_idx, start_idx);
+            if (isfinite(f_ss[start_idx]) and isfinite(norm_squared_ss) and sqrt(norm_squared_ss) <= max_norm_ss)
+                kept_idx_ss.push_back(start_idx);
+        }
+
+        // the best f first: the smallest f for a minimization, the largest f for a maximization
+        int min_max_ss{input_ms.get_min_max()};
+        stable_sort(kept_idx_ss.begin(), kept_idx_ss.end(),
+                    [&f_ss, min_max_ss](const size_t &a, const size_t &b) {
+                        return (min_max_ss == 1) ? (f_ss[a] > f_ss[b]) : (f_ss[a] < f_ss[b]);
+                    });
+        if (kept_idx_ss.size() > options.num_of_screened_starts)
+            kept_idx_ss.resize(options.num_of_screened_starts);
+
+        vector<vector<T>> screened_starts;
+        screened_starts.reserve(kept_idx_ss.size());
+        for (const size_t &start_idx : kept_idx_ss)
+            screened_starts.push_back(starts[start_idx]);
+        starts.swap(screened_starts);
+    }
+
+    /**
+     * @brief Private member function used to run every algorithm from every initial point on a Thread_Pool
+     * @param num_of_threads The number of worker threads, 0 uses the number of hardware threads
+     */
+    void run_all(const size_t &num_of_threads)
+    {
+        size_t num_of_algorithms{options.algorithms.size()};
+        runs.assign(starts.size() * num_of_algorithms, Run_Result{});
+
+        Thread_Pool pool(num_of_threads);
+        num_of_threads_used = pool.get_num_of_threads();
+        // one workspace per worker, a worker runs one task at a time
+        vector<Solver_Workspace<T>> workspaces;
+        workspaces.reserve(num_of_threads_used);
+        for (size_t worker_idx{0}; worker_idx < num_of_threads_used; worker_idx++)
+            workspaces.emplace_back(polyn_ms);
+
+        for (size_t start_idx{0}; start_idx < starts.size(); start_idx++)
+            for (size_t alg_idx{0}; alg_idx < num_of_algorithms; alg_idx++)
+            {
+                size_t run_idx{start_idx * num_of_algorithms + alg_idx};
+                pool.submit([this, &workspaces, start_idx, alg_idx, run_idx](size_t worker_idx) {
+                    Null_Observer observer_ms;
+                    Run_Result &run_ms{runs[run_idx]};
+                    run_ms.case_num = input_ms.run_algorithm(options.algorithms[alg_idx], starts[start_idx],
+                                                             run_ms.x_final, workspaces[worker_idx], observer_ms);
+                });
+            }
+        pool.wait();
+    }
+
+    /**
+     * @brief Private member function used to merge the converged runs into the distinct stationary points,
+     * in the order of the initial points, two points are the same if their distance is less than sqrt(tolerance)
+     */
+    void merge_stationary_points()
+    {
+        size_t num_of_algorithms{options.algorithms.size()};
+        case_counts.assign(num_of_algorithms, vector<size_t>(7, 0));
+        T same_point_distance{sqrt(input_ms.get_tolerance())};
+
+        for (size_t run_idx{0}; run_idx < runs.size(); run_idx++)
+        {
+            const Run_Result &run_ms{runs[run_idx]};
+            size_t alg_idx{run_idx % num_of_algorithms};
+            if (run_ms.case_num >= 1 and run_ms.case_num <= 6)
+                case_counts[alg_idx][run_ms.case_num]++;
+            if (run_ms.case_num != 1)
+                continue;
+
+            bool is_new_point{true};
+            for (Stationary_Point<T> &point : stationary_points)
+            {
+                T distance_squared{0};
+                for (size_t x_idx{0}; x_idx < point.x.size(); x_idx++)
+                    distance_squared += (point.x[x_idx] - run_ms.x_final[x_idx]) * (point.x[x_idx] - run_ms.x_final[x_idx]);
+                if (sqrt(distance_squared) < same_point_distance)
+                {
+                    point.num_of_runs[alg_idx]++;
+                    is_new_point = false;
+                    break;
+                }
+            }
+            if (is_new_point)
+            {
+                Stationary_Point<T> new_point{run_ms.x_final, polyn_ms.eval_f(run_ms.x_final),
+                                              vector<size_t>(num_of_algorithms, 0)};
+                new_point.num_of_runs[alg_idx] = 1;
+                stationary_points.push_back(new_point);
+            }
+        }
+
+        // the best point first: the smallest f for a minimization, the largest f for a maximization
+        int min_max_ms{input_ms.get_min_max()};
+        stable_sort(stationary_points.begin(), stationary_points.end(),
+                    [min_max_ms](const Stationary_Point<T> &a, const Stationary_Point<T> &b) {
+                        return (min_max_ms == 1) ? (a.f > b.f) : (a.f < b.f);
+                    });
+    }
+};
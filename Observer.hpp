@@ -0,0 +1,100 @@
+/**
+ * @file Observer.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A Null_Observer class, the observer of an optimization algorithm that does nothing,
+ * and a Stop_Observer class, the observer used to cancel an optimization algorithm from another thread
+ *
+ * @details The optimization algorithms of Input_Data take an observer as a template parameter
+ * and call it with the state of each iteration. An observer is any class with:
+ * - static constexpr bool observes_iterations: if false, the algorithm does not call
+ *   begin_iteration/end_iteration and does not compute values that only the observer needs
+ * - void begin_iteration(const size_t &iteration, const vector<T> &x, const T &f,
+ *   const vector<T> &gradient, const T &norm): called at the start of each iteration (1-based),
+ *   the last call is the last iteration of the algorithm
+ * - void end_iteration(const T &step, const vector<T> &direction): called when the iteration
+ *   moves from x to x + step * direction
+ * - static constexpr bool can_stop: if true, the algorithm calls bool stop_requested() const
+ *   at the start of each iteration and after its inner loops (the line search, the trust region subproblem,
+ *   the damping trials of levenberg_marquardt), and returns case 5 as soon as it returns true.
+ *   The line searches and the trust region subproblem poll the stop_flag of the Solver_Workspace instead,
+ *   thus the owner of the flag also sets it in the workspace (see Algorithm_Race.hpp) <br>
+ * Iteration_Trace (see Iteration_Trace.hpp) is the observer that stores the iterations to the
+ * output_iterations files. Null_Observer is used when only the result of the algorithm is needed,
+ * all of its member functions are empty, so the calls compile away. Stop_Observer only
+ * polls a shared stop flag, it is used by Algorithm_Race (see Algorithm_Race.hpp) to cancel
+ * the algorithms that lost the race
+ */
+
+#pragma once
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief A class for an observer that ignores every iteration
+ */
+class Null_Observer
+{
+public:
+    static constexpr bool observes_iterations{false};
+    static constexpr bool can_stop{false};
+
+    /**
+     * @brief Public member function called at the start of each iteration, does nothing
+     */
+    template <typename T>
+    void begin_iteration(const size_t &, const vector<T> &, const T &, const vector<T> &, const T &) {}
+
+    /**
+     * @brief Public member function called when an iteration moves to the next x, does nothing
+     */
+    template <typename T>
+    void end_iteration(const T &, const vector<T> &) {}
+};
+
+/**
+ * @brief A class for an observer that ignores every iteration, but stops the algorithm
+ * once a stop flag shared with other threads is set
+ */
+class Stop_Observer
+{
+public:
+    static constexpr bool observes_iterations{false};
+    static constexpr bool can_stop{true};
+
+    /**
+     * @brief Construct a new Stop_Observer object
+     * @param input_stop_flag The shared stop flag, it must outlive the observer
+     */
+    Stop_Observer(const atomic<bool> &input_stop_flag) : stop_flag(input_stop_flag) {}
+
+    /**
+     * @brief Public member function called at the start of each iteration, does nothing
+     */
+    template <typename T>
+    void begin_iteration(const size_t &, const vector<T> &, const T &, const vector<T> &, const T &) {}
+
+    /**
+     * @brief Public member function called when an iteration moves to the next x, does nothing
+     */
+    template <typename T>
+    void end_iteration(const T &, const vector<T> &) {}
+
+    /**
+     * @brief Public member function used to check whether another thread requested the algorithm to stop
+     * @return true if the stop flag is set
+     */
+    bool stop_requested() const
+    {
+        // only the flag itself is shared, thus no ordering with other memory is needed
+        return stop_flag.load(memory_order_relaxed);
+    }
+
+private:
+    const atomic<bool> &stop_flag; // set by another thread to stop the algorithm
+};
@@ -0,0 +1,148 @@
+/**
+ * @file Point_Batch.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ * 
+ * @brief A Point_Batch class that stores many x points in structure-of-arrays form
+ * 
+ * @details This library contains a class Point_Batch used by the batched evaluation functions
+ * of Polynomial (eval_f_batch, gradient_f_batch). The values of each x variable are stored
+ * contiguously for all points in double precision, so the same operation can be applied to
+ * consecutive points with SIMD instructions (compile with -O3 -march=native to let the
+ * compiler use AVX2/AVX-512 lanes)
+ */
+
+#pragma once
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief A class for a batch of x points
+ */
+class Point_Batch
+{
+public:
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Point_Batch object with all values set to zero
+     * @param input_num_of_x_vars The number of x variables of each point
+     * @param input_num_of_points The number of points
+     */
+    Point_Batch(const size_t &input_num_of_x_vars, const size_t &input_num_of_points)
+        : num_of_x_vars(input_num_of_x_vars), num_of_points(input_num_of_points),
+          stride((input_num_of_points + lane_padding - 1) / lane_padding * lane_padding),
+          values(input_num_of_x_vars * stride, 0.0) {}
+
+    // ======================================================================
+    // Public member functions of Point_Batch: get/set values
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the number of x variables
+     * @return size_t The number of x variables of each point
+     */
+    size_t get_num_of_x_vars() const
+    {
+        return num_of_x_vars;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the number of points
+     * @return size_t The number of points
+     */
+    size_t get_num_of_points() const
+    {
+        return num_of_points;
+    }
+
+    /**
+     * @brief Overloaded operator () used to access the value of x_(x_idx+1) of a point WITHOUT range checking
+     * @param x_idx The 0-based index of the x variable
+     * @param point_idx The index of the point
+     * @return double& A reference to the value, thus allows modification of the value
+     */
+    double &operator()(const size_t &x_idx, const size_t &point_idx)
+    {
+        return values[x_idx * stride + point_idx];
+    }
+
+    /**
+     * @brief Overloaded operator () used to access the value of x_(x_idx+1) of a point WITHOUT range checking
+     * @param x_idx The 0-based index of the x variable
+     * @param point_idx The index of the point
+     * @return double The value, does not allow modification of the value
+     */
+    double operator()(const size_t &x_idx, const size_t &point_idx) const
+    {
+        return values[x_idx * stride + point_idx];
+    }
+
+    /**
+     * @brief Public member function used to access the contiguous values of x_(x_idx+1) of all points
+     * @param x_idx The 0-based index of the x variable
+     * @return const double* A pointer to the value of the first point
+     */
+    const double *x_values(const size_t &x_idx) const
+    {
+        return values.data() + x_idx * stride;
+    }
+
+    /**
+     * @brief Public member function used to access the contiguous values of x_(x_idx+1) of all points
+     * @param x_idx The 0-based index of the x variable
+     * @return double* A pointer to the value of the first point, thus allows modification of the values
+     */
+    double *x_values(const size_t &x_idx)
+    {
+        return values.data() + x_idx * stride;
+    }
+
+    /**
+     * @brief Public member function used to store a point in the batch
+     * @tparam T The scalar type of the point, its values are rounded to double
+     * @param point_idx The index of the point
+     * @param x_vars_sp A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     */
+    template <typename T>
+    void set_point(const size_t &point_idx, const vector<T> &x_vars_sp)
+    {
+        for (size_t x_idx{0}; x_idx < num_of_x_vars; x_idx++)
+            values[x_idx * stride + point_idx] = static_cast<double>(x_vars_sp.at(x_idx));
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) a point of the batch
+     * @tparam T The scalar type of the returned point, for example "batch.get_point<float>(0)"
+     * @param point_idx The index of the point
+     * @return vector<T> A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     */
+    template <typename T>
+    vector<T> get_point(const size_t &point_idx) const
+    {
+        vector<T> x_vars_gp(num_of_x_vars);
+        for (size_t x_idx{0}; x_idx < num_of_x_vars; x_idx++)
+            x_vars_gp[x_idx] = static_cast<T>(values[x_idx * stride + point_idx]);
+        return x_vars_gp;
+    }
+
+private:
+    // ======================================================================
+    // Private data of Point_Batch
+    // ======================================================================
+
+    // each row is padded to a multiple of 8 doubles (64 bytes, one AVX-512 register)
+    static constexpr size_t lane_padding{8};
+
+    size_t num_of_x_vars; // number of x variables of each point
+    size_t num_of_points; // number of points
+    size_t stride;        // distance between the rows of two consecutive x variables
+
+    // values of x_1 for all points, then values of x_2 for all points, ...
+    vector<double> values;
+};
@@ -13,12 +13,84 @@
 #include <string>
 #include <vector>
 #include "matrix.hpp"
+#include "Point_Batch.hpp"
 
 using namespace std;
 
+/**
+ * @brief A compiled sparse (CSR-style) representation of the terms of a polynomial
+ * @details Term t is coeffs[t] * x_(x_idx[k]+1)^exps[k] * ... for all k in [offsets[t], offsets[t+1]),
+ * only the x variables that actually appear in a term are stored, so the memory and the cost
+ * of evaluation scale with the number of nonzero factors instead of terms * x variables
+ */
+template <typename T>
+struct Sparse_Terms
+{
+    vector<T> coeffs;          // coefficient of each term
+    vector<size_t> offsets{0}; // term t owns the factors in [offsets[t], offsets[t+1])
+    vector<size_t> x_idx;      // 0-based index of the x variable of each factor
+    vector<unsigned int> exps; // positive integer exponent of each factor
+};
+
+/**
+ * @brief A node of the multivariate Horner form of a polynomial
+ * @details The value of a node is constant + x_(x_idx+1)^exp * value(mul_child) + value(add_child),
+ * a child equal to Horner_Node<T>::none is skipped. <br>
+ * Ex: "f(x_1,x_2)=1+x_1+x_1^2*x_2" is compiled into 1 + x_1 * (1 + x_1 * x_2)
+ */
+template <typename T>
+struct Horner_Node
+{
+    static constexpr size_t none{static_cast<size_t>(-1)}; // a missing child
+
+    T constant{0};          // constant added to the node
+    size_t x_idx{0};        // 0-based index of the x variable factored out
+    unsigned int exp{0};    // exponent of the x variable factored out
+    size_t mul_child{none}; // node multiplied by x_(x_idx+1)^exp
+    size_t add_child{none}; // node added to the node, the terms without x_(x_idx+1)
+};
+
+/**
+ * @brief Function used to count the multiplications int_pow needs for the given exponent
+ * @param exp_pmc The non-negative integer exponent
+ * @return size_t The number of squarings plus the number of extra multiplications
+ */
+inline size_t pow_mult_count(unsigned int exp_pmc)
+{
+    size_t count_pmc{0};
+    for (unsigned int bits_pmc{exp_pmc}; bits_pmc > 1; bits_pmc >>= 1)
+        count_pmc += 1 + (bits_pmc & 1U); // one squaring, and one multiplication for each extra set bit
+    return count_pmc;
+}
+
+/**
+ * @brief Function used to evaluate base^exponent by repeated squaring, which is exact
+ * for integer exponents and much cheaper than pow(T, T)
+ * @param base_ip The base
+ * @param exp_ip The non-negative integer exponent
+ * @return T The value of base^exponent
+ */
+template <typename T>
+inline T int_pow(T base_ip, unsigned int exp_ip)
+{
+    T result_ip{1};
+    while (exp_ip > 0)
+    {
+        if (exp_ip & 1U)
+            result_ip *= base_ip;
+        exp_ip >>= 1;
+        if (exp_ip > 0)
+            base_ip *= base_ip;
+    }
+    return result_ip;
+}
+
 /**
  * @brief A class for polynomial
+ * @tparam T The scalar type used for the coefficients and the x values, 
+ * explicitly instantiated for float, double and long double
  */
+template <typename T>
 class Polynomial
 {
 public:
@@ -63,13 +135,35 @@ public:
     /**
      * @brief Public member function used to obtain (but not modify) 
      * the coefficient/exponent matrix
-     * @return matrix<long double> The coefficient/exponent matrix <br>
+     * @return matrix<T> The coefficient/exponent matrix <br>
      * - The coeff_exp_mtx matrix has the size (num_of_terms, 1 + num_of_x_vars)
      * - Each row stores a term from the polynomial function
      * - First column is the coefficient of the terms
      * - Other columns are the exponents of the x variables
      */
-    matrix<long double> get_coeff_exp_mtx() const;
+    matrix<T> get_coeff_exp_mtx() const;
+
+    /**
+     * @brief Public member function used to obtain (but not modify) 
+     * the compiled sparse terms of Polynomial
+     * @return const Sparse_Terms<T>& The sparse terms, see Sparse_Terms
+     */
+    const Sparse_Terms<T> &get_terms() const;
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the number of 
+     * multiplications needed to evaluate the polynomial term by term
+     * @return size_t The number of multiplications of one term by term evaluation
+     */
+    size_t get_naive_mult_count() const;
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the number of 
+     * multiplications needed to evaluate the multivariate Horner form of the polynomial, 
+     * which is what eval_f uses
+     * @return size_t The number of multiplications of one eval_f call
+     */
+    size_t get_horner_mult_count() const;
 
     // ======================================================================
     // Public member functions of Polynomial: evaluate functions
@@ -77,49 +171,119 @@ public:
 
     /**
      * @brief Public member function used to evaluate (but not modify) the polynomial 
-     * f(x_1, x_2, ...) based on the given vector of x values [x_1, x_2, ...]
-     * @param x_vars_ef A vector of long doubles that stores the values of [x_1, x_2, ...]
-     * @return long double The resulting value of f(x_1, x_2, ...)
+     * f(x_1, x_2, ...) based on the given vector of x values [x_1, x_2, ...]. <br>
+     * The multivariate Horner form compiled in the constructor is evaluated, so the powers and
+     * the products shared by several terms are only computed once
+     * @param x_vars_ef A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @return T The resulting value of f(x_1, x_2, ...)
      * @throws err_invalid_x_vector if the given x vector and the polynomial have different numbers of x variables
      */
-    long double eval_f(const vector<long double> &) const;
+    T eval_f(const vector<T> &) const;
 
     /**
      * @brief Public member function used to evaluate (but not modify) the partial derivate of
-     * f(x_1, x_2, ...) with respect to x_i, where i is the index of the x variable
-     * @param x_vars_ed A vector of long doubles that stores the values of [x_1, x_2, ...]
+     * f(x_1, x_2, ...) with respect to x_i, where i is the index of the x variable. <br>
+     * The partial derivative is exact, it is evaluated from the derivative polynomial
+     * precomputed in the constructor
+     * @param x_vars_ed A vector of scalars of type T that stores the values of [x_1, x_2, ...]
      * @param x_idx_ed The index of the x variable (with respect to) used to evaluate partial derivate
-     * @return long double The partial derivate of f(x_1, x_2, ...) with respect to x_i
+     * @return T The partial derivate of f(x_1, x_2, ...) with respect to x_i
      * @throws err_invalid_x_vector if the given x vector and the polynomial have different numbers of x variables
      */
-    long double eval_df(const vector<long double> &, const size_t &) const;
+    T eval_df(const vector<T> &, const size_t &) const;
 
     /**
      * @brief Public member function used to evaluate (but not modify) 
-     * the gradient of f(x_1, x_2, ...) based on the given vector of x values
-     * @param x_vars_gf A vector of long doubles that stores the values of [x_1, x_2, ...]
-     * @return vector<long double> A vector of long doubles that represents the gradient of the given vector 
+     * the gradient of f(x_1, x_2, ...) based on the given vector of x values. <br>
+     * The gradient is exact, each component is evaluated from the derivative polynomial
+     * precomputed in the constructor, thus the cost scales with the number of nonzero factors
+     * @param x_vars_gf A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @return vector<T> A vector of scalars of type T that represents the gradient of the given vector 
      * @throws err_invalid_x_vector if the given x vector and the polynomial have different numbers of x variables
      */
-    vector<long double> gradient_f(const vector<long double> &) const;
+    vector<T> gradient_f(const vector<T> &) const;
+
+    /**
+     * @brief Public member function used to evaluate (but not modify)
+     * the gradient of f(x_1, x_2, ...) into a given vector without allocating memory
+     * @param x_vars_gf A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @param gradient_gf A vector of scalars of type T of size get_num_of_x_vars(), overwritten with the gradient
+     * @throws err_invalid_x_vector if the given x vector or gradient vector and the polynomial
+     * have different numbers of x variables
+     */
+    void gradient_f(const vector<T> &, vector<T> &) const;
 
     /**
      * @brief Public member function used to evaluate (but not modify) 
-     * the hessian of f(x_1, x_2, ...) based on the given vector of x values
-     * @param x_vars_hf A vector of long doubles that stores the values of [x_1, x_2, ...]
-     * @return matrix<long double> A matrix of long doubles that represents the hessian of the given vector 
+     * the hessian of f(x_1, x_2, ...) based on the given vector of x values. <br>
+     * The hessian is exact, each term only adds to the (i, j) entries of the x variables it contains,
+     * the upper triangle is accumulated and then mirrored since the hessian is symmetric
+     * @param x_vars_hf A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @return matrix<T> A matrix of scalars of type T that represents the hessian of the given vector 
      * @throws err_invalid_x_vector if the given x vector and the polynomial have different numbers of x variables
      */
-    matrix<long double> hessian_f(const vector<long double> &) const;
+    matrix<T> hessian_f(const vector<T> &) const;
+
+    /**
+     * @brief Public member function used to evaluate (but not modify)
+     * the hessian of f(x_1, x_2, ...) into a given matrix without allocating memory
+     * once the scratch vector is large enough
+     * @param x_vars_hf A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @param hessian_mtx A square matrix of size get_num_of_x_vars(), overwritten with the hessian
+     * @param scratch_hf A vector of scalars of type T used to store the values of the factors of a term,
+     * it only grows (to 3 times the largest number of factors in a term), so it can be reused between calls
+     * @throws err_invalid_x_vector if the given x vector or hessian matrix and the polynomial
+     * have different numbers of x variables
+     */
+    void hessian_f(const vector<T> &, matrix<T> &, vector<T> &) const;
+
+    /**
+     * @brief Public member function used to evaluate (but not modify) the product of the hessian
+     * of f(x_1, x_2, ...) and a given vector without forming the hessian. <br>
+     * Each term adds its second derivatives times the vector directly to the product,
+     * thus the cost scales with the number of nonzero factors and no n x n matrix is needed
+     * @param x_vars_hvf A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @param vec_hvf A vector of scalars of type T of size get_num_of_x_vars() multiplied by the hessian
+     * @param product_hvf A vector of scalars of type T of size get_num_of_x_vars(), overwritten with hessian * vec_hvf
+     * @param scratch_hvf A vector of scalars of type T used to store the values of the factors of a term,
+     * see hessian_f
+     * @throws err_invalid_x_vector if the given vectors and the polynomial have different numbers of x variables
+     */
+    void hessian_vector_f(const vector<T> &, const vector<T> &, vector<T> &, vector<T> &) const;
 
     /**
      * @brief Public member function used to evaluate (but not modify) 
      * the inverse hessian of f(x_1, x_2, ...) based on the given vector of x values
-     * @param x_vars_ihf A vector of long doubles that stores the values of [x_1, x_2, ...]
-     * @return matrix<long double> A matrix of long doubles that represents the inverse hessian of the given vector 
+     * @param x_vars_ihf A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @return matrix<T> A matrix of scalars of type T that represents the inverse hessian of the given vector 
      * @throws err_invalid_x_vector if the given x vector and the polynomial have different numbers of x variables
+     * @throws matrix<T>::singular_matrix if the hessian is singular
+     */
+    matrix<T> inverse_hessian_f(const vector<T> &) const;
+
+    // ======================================================================
+    // Public member functions of Polynomial: batched evaluate functions
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to evaluate (but not modify) the polynomial 
+     * f(x_1, x_2, ...) at every point of a batch together in double precision. <br>
+     * Each term is evaluated for all points at once, the loops over the points are
+     * contiguous so they run on SIMD lanes
+     * @param points_efb A batch of points
+     * @param results_efb A vector of doubles, resized to the number of points and overwritten with f at each point
+     * @throws err_invalid_x_vector if the points and the polynomial have different numbers of x variables
      */
-    matrix<long double> inverse_hessian_f(const vector<long double> &) const;
+    void eval_f_batch(const Point_Batch &, vector<double> &) const;
+
+    /**
+     * @brief Public member function used to evaluate (but not modify) the gradient of 
+     * f(x_1, x_2, ...) at every point of a batch together in double precision
+     * @param points_gfb A batch of points
+     * @param gradients_gfb A batch with the same size as points_gfb, overwritten with the gradient at each point
+     * @throws err_invalid_x_vector if the batches and the polynomial have different numbers of x variables
+     */
+    void gradient_f_batch(const Point_Batch &, Point_Batch &) const;
 
 private:
     // ======================================================================
@@ -130,15 +294,30 @@ private:
     size_t num_of_x_vars; // number of x variables in the polynomial function
     size_t num_of_terms;  // number of terms on the RHS of the polynomial function
 
-    // A matrix storing the coefficients and the exponents of the polynomial function
-    // coeff_exp_mtx matrix should have the size (num_of_terms, 1+num_of_x_vars)
-    // Each row stores a term from the polynomial function
-    // First column is the coefficient of the terms
-    // Other columns are the exponents of the different x variables
-    // Ex: polynomial function "f(x_1,x_2)=x_1^2-x_2^2" has the following coeff_exp_mtx:
-    //     ( 1   2   0 )   first row represents:  1 * x_1^2 * x_2^0   <-  term index 0: x_1^2
-    //     ( -1  0   2 )   second row represents: -1 * x_1^0 * x_2^2  <-  term index 1: -x_2^2
-    matrix<long double> coeff_exp_mtx;
+    // The compiled sparse terms storing the coefficients and the exponents of the polynomial function
+    // Each term stores its coefficient and a list of (x variable index, exponent) pairs,
+    // x variables with a zero exponent are not stored
+    // Ex: polynomial function "f(x_1,x_2)=x_1^2-x_2^2" has the following terms:
+    //     coeffs  = ( 1, -1 )
+    //     offsets = ( 0, 1, 2 )   term index 0 owns factor 0, term index 1 owns factor 1
+    //     x_idx   = ( 0, 1 )      factor 0 is x_1, factor 1 is x_2
+    //     exps    = ( 2, 2 )      1 * x_1^2  <-  term index 0,  -1 * x_2^2  <-  term index 1
+    // The dense coeff_exp_mtx matrix is only generated on request, see get_coeff_exp_mtx()
+    Sparse_Terms<T> terms;
+
+    // The partial derivative polynomials df/dx_1, df/dx_2, ... derived symbolically from terms
+    // All derivative terms are stored together, grouped by x variable:
+    // the terms [df_offsets[i], df_offsets[i+1]) of df_terms represent df/dx_(i+1)
+    // Ex: polynomial function "f(x_1,x_2)=x_1^2*x_2" has df/dx_1 = 2*x_1*x_2 and df/dx_2 = x_1^2
+    Sparse_Terms<T> df_terms;
+    vector<size_t> df_offsets;
+
+    // The multivariate Horner form of the polynomial, node 0 is the root
+    // It is built greedily: the x variable found in the most terms is factored out with its
+    // smallest exponent, ex: x_1^2 + x_1^4 - x_1^2*x_2 = x_1^2 * (1 + x_1^2 - x_2)
+    vector<Horner_Node<T>> horner_nodes;
+    size_t naive_mult_count{0};  // multiplications of one term by term evaluation
+    size_t horner_mult_count{0}; // multiplications of one evaluation of horner_nodes
 
     // ======================================================================
     // Private member functions of Polynomial: validate polynomial string
@@ -165,50 +344,76 @@ private:
     /**
      * @brief Private member function used to check the validity of the expression 
      * on the right side (RHS) of the polynomial string. <br>
-     * The private Polynomial data num_of_terms and coeff_exp_mtx are updated if the RHS is valid
+     * The private Polynomial data num_of_terms and terms are updated if the RHS is valid
      * @param rhs_str_cvrp The string representation of the RHS of the polynomial function
      * @throws err_invalid_rhs_poly if the polynomial's RHS, the expression on the right side of '=' is invalid
      */
     void check_valid_rhs_poly(const string &);
 
+    /**
+     * @brief Private member function used to derive the partial derivative polynomials 
+     * from the sparse terms of the polynomial. <br>
+     * The private Polynomial data df_terms and df_offsets are updated
+     */
+    void compile_derivatives();
+
+    /**
+     * @brief Private member function used to compile the given terms into a chain of 
+     * multivariate Horner nodes, which is appended to the private Polynomial data horner_nodes. <br>
+     * horner_mult_count is updated with the multiplications of the new nodes
+     * @param terms_ch The sparse terms to compile
+     * @return size_t The index of the first node of the chain
+     */
+    size_t compile_horner(const Sparse_Terms<T> &);
+
     // ======================================================================
     // Private member functions of Polynomial: evaluate functions
     // ======================================================================
 
     /**
-     * @brief Private member function used to evaluate the (i, j) cofactor of a given matrix
-     * @param mtx_cof A square matrix of long doubles
-     * @param mtx_size_cof The size of the square matrix
-     * @param remove_row_cof The row index i of the (i, j) cofactor
-     * @param remove_col_cof The col index j of the (i, j) cofactor
-     * @return long double The (i, j) cofactor of the given matrix
+     * @brief Private member function used to evaluate the sum of the terms 
+     * [first_term, last_term) of the given sparse terms at the given vector of x values
+     * @param terms_et The sparse terms to evaluate
+     * @param first_term_et The index of the first term to evaluate
+     * @param last_term_et One past the index of the last term to evaluate
+     * @param x_vars_et A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @return T The sum of the evaluated terms
      */
-    long double cofactor(const matrix<long double> &,
-                         const size_t &, const size_t &, const size_t &) const;
+    T eval_terms(const Sparse_Terms<T> &, const size_t &, const size_t &,
+                           const vector<T> &) const;
 
     /**
-     * @brief Private member function used to evaluate the determinant of a given matrix
-     * @param mtx_det A square matrix of long doubles
-     * @param mtx_size_det The size of the square matrix
-     * @return long double The determinant of the given matrix
+     * @brief Private member function used to evaluate the sum of the terms 
+     * [first_term, last_term) of the given sparse terms at every point of a batch
+     * @param terms_etb The sparse terms to evaluate
+     * @param first_term_etb The index of the first term to evaluate
+     * @param last_term_etb One past the index of the last term to evaluate
+     * @param points_etb A batch of points
+     * @param results_etb Overwritten with the sum of the evaluated terms at each point
+     * @param term_buf_etb Scratch space for the value of a term at each point
+     * @param base_buf_etb Scratch space for the repeated squaring at each point
      */
-    long double determinant(const matrix<long double> &, const size_t &) const;
+    void eval_terms_batch(const Sparse_Terms<T> &, const size_t &, const size_t &, const Point_Batch &,
+                          double *, double *, double *) const;
 
     /**
-     * @brief Private member function used to evaluate the adjugate matrix of a given matrix
-     * @param mtx_adj A square matrix of long doubles
-     * @param mtx_size_adj The size of the square matrix
-     * @return matrix<long double> The adjugate matrix of the given matrix
+     * @brief Private member function used to evaluate the chain of Horner nodes starting
+     * at the given node at the given vector of x values
+     * @param node_idx_eh The index of the first node of the chain
+     * @param x_vars_eh A vector of scalars of type T that stores the values of [x_1, x_2, ...]
+     * @return T The value of the chain of Horner nodes
      */
-    matrix<long double> adjugate_mtx(const matrix<long double> &, const size_t &) const;
+    T eval_horner(size_t, const vector<T> &) const;
 
     /**
      * @brief Private member function used to evaluate the inverse matrix of a given matrix
-     * @param mtx_inv A square matrix of long doubles
+     * by solving for the columns of the identity matrix with an LU factorization
+     * @param mtx_inv A square matrix of scalars of type T
      * @param mtx_size_inv The size of the square matrix
-     * @return matrix<long double> The inverse matrix of the given matrix
+     * @return matrix<T> The inverse matrix of the given matrix
+     * @throws matrix<T>::singular_matrix if the given matrix is singular
      */
-    matrix<long double> inverse_mtx(const matrix<long double> &, const size_t &) const;
+    matrix<T> inverse_mtx(const matrix<T> &, const size_t &) const;
 };
 
 // ======================================================================
@@ -223,4 +428,5 @@ private:
  * @return ostream& A reference to the output stream
  */
 // Overloaded binary operator << used to easily print out a Polynomial to a stream
-ostream &operator<<(ostream &, const Polynomial &);
\ No newline at end of file
+template <typename T>
+ostream &operator<<(ostream &, const Polynomial<T> &);
\ No newline at end of file
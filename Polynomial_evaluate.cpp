@@ -1,6 +1,7 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include "Polynomial.hpp"
 #include "matrix.hpp"
 #include "vector_overloads.hpp"
@@ -13,167 +14,331 @@ using namespace std;
 // ======================================================================
 // see Polynomial.hpp for description
 
-long double Polynomial::eval_f(const vector<long double> &x_vars_ef) const
+template <typename T>
+T Polynomial<T>::eval_f(const vector<T> &x_vars_ef) const
 {
-    long double result_value{0};           // initialize the resulting value
     if (x_vars_ef.size() != num_of_x_vars) // if x_vars_ef has incorrect size
         throw err_invalid_x_vector();
-    for (size_t term_idx_e{0}; term_idx_e < num_of_terms; term_idx_e++)
-    {
-        long double term_value{0}; // each term has its own term value
-        for (size_t x_var_idx_e{0}; x_var_idx_e < num_of_x_vars + 1; x_var_idx_e++)
-        {
-            long double curr_mtx_value{coeff_exp_mtx(term_idx_e, x_var_idx_e)};
-            if (x_var_idx_e == 0)
-            {
-                term_value = curr_mtx_value; // coefficient
-            }
-            else
-            {
-                // term = coefficient * x_1^exponent * x_2^exponent * ...
-                term_value *= pow(x_vars_ef.at(x_var_idx_e - 1), curr_mtx_value);
-            }
-        };
-        result_value += term_value; // result = term_0 + term_1 + term_2 + ...
-    };
-    return result_value;
+    // the root of the multivariate Horner form is node 0
+    return eval_horner(0, x_vars_ef);
 }
 
-long double Polynomial::eval_df(const vector<long double> &x_vars_ed, const size_t &x_idx_ed) const
+template <typename T>
+T Polynomial<T>::eval_df(const vector<T> &x_vars_ed, const size_t &x_idx_ed) const
 {
-    constexpr long double h{0.0000000001L};                 // 1*10^-10, quotient h approaches to zero
-    vector<long double> x_vars_plus_h(num_of_x_vars, 0.0L); // vector of x variables when x_i+h
-    if (x_vars_ed.size() != num_of_x_vars)                  // if x_vars_ed has incorrect size
+    if (x_vars_ed.size() != num_of_x_vars) // if x_vars_ed has incorrect size
         throw err_invalid_x_vector();
-    x_vars_plus_h.at(x_idx_ed - 1) = h; // [0, ..., 0, h, 0, ...]
-    x_vars_plus_h += x_vars_ed;         // [x_1, ..., x_(i-1), (x_i)+h, x_(i+1), ...]
-    return (eval_f(x_vars_plus_h) - eval_f(x_vars_ed)) / h;
+    // df/dx_i is stored as the terms [df_offsets[i-1], df_offsets[i]) of df_terms
+    return eval_terms(df_terms, df_offsets.at(x_idx_ed - 1), df_offsets.at(x_idx_ed), x_vars_ed);
 }
 
-vector<long double> Polynomial::gradient_f(const vector<long double> &x_vars_gf) const
+template <typename T>
+vector<T> Polynomial<T>::gradient_f(const vector<T> &x_vars_gf) const
 {
-    vector<long double> gradient_vec(num_of_x_vars, 0); // gradient, a vector of long double
-    if (x_vars_gf.size() != num_of_x_vars)              // if x_vars_gf has incorrect size
+    vector<T> gradient_vec(num_of_x_vars, 0); // gradient, a vector of T
+    gradient_f(x_vars_gf, gradient_vec);
+    return gradient_vec;
+}
+
+template <typename T>
+void Polynomial<T>::gradient_f(const vector<T> &x_vars_gf, vector<T> &gradient_gf) const
+{
+    // if x_vars_gf or gradient_gf has incorrect size
+    if (x_vars_gf.size() != num_of_x_vars or gradient_gf.size() != num_of_x_vars)
         throw err_invalid_x_vector();
     for (size_t x_idx_gf{0}; x_idx_gf < num_of_x_vars; x_idx_gf++)
     {
         // assign the partial derivative(f with respect to x_1, x_2, ...) the the gradient
-        gradient_vec.at(x_idx_gf) = eval_df(x_vars_gf, x_idx_gf + 1);
+        gradient_gf[x_idx_gf] = eval_terms(df_terms, df_offsets[x_idx_gf], df_offsets[x_idx_gf + 1], x_vars_gf);
     };
-    return gradient_vec;
 }
 
-matrix<long double> Polynomial::hessian_f(const vector<long double> &x_vars_hf) const
+template <typename T>
+matrix<T> Polynomial<T>::hessian_f(const vector<T> &x_vars_hf) const
 {
-    constexpr long double h{0.00001L}; // 1*10^-5, quotient h approaches to zero
+    matrix<T> hessian_mtx(num_of_x_vars, num_of_x_vars); // hessian, a matrix of T
+    vector<T> scratch_hf;
+    hessian_f(x_vars_hf, hessian_mtx, scratch_hf);
+    return hessian_mtx;
+}
 
-    matrix<long double> hessian_mtx(num_of_x_vars, num_of_x_vars); // hessian, a matrix of long double
-    vector<long double> gd_hf(gradient_f(x_vars_hf));              // gradient for current x
-    vector<long double> gd_gd_hf(num_of_x_vars, 0);                // gradient of gradient
+template <typename T>
+void Polynomial<T>::hessian_f(const vector<T> &x_vars_hf, matrix<T> &hessian_mtx, vector<T> &scratch_hf) const
+{
+    // if x_vars_hf or hessian_mtx has incorrect size
+    if (x_vars_hf.size() != num_of_x_vars or hessian_mtx.get_rows() != num_of_x_vars or
+        hessian_mtx.get_cols() != num_of_x_vars)
+        throw err_invalid_x_vector();
+    for (size_t row_idx_hf{0}; row_idx_hf < num_of_x_vars; row_idx_hf++)
+        for (size_t col_idx_hf{0}; col_idx_hf < num_of_x_vars; col_idx_hf++)
+            hessian_mtx(row_idx_hf, col_idx_hf) = 0;
 
-    if (x_vars_hf.size() != num_of_x_vars) // if x_vars_gf has incorrect size
+    for (size_t term_idx_hf{0}; term_idx_hf < num_of_terms; term_idx_hf++)
+    {
+        size_t first_hf{terms.offsets[term_idx_hf]};
+        size_t num_of_factors_hf{terms.offsets[term_idx_hf + 1] - first_hf};
+        if (scratch_hf.size() < 3 * num_of_factors_hf)
+            scratch_hf.resize(3 * num_of_factors_hf);
+        // for each factor x_i^e of the current term store x_i^e, e*x_i^(e-1) and e*(e-1)*x_i^(e-2)
+        T *pow_hf{scratch_hf.data()};
+        T *d1_hf{pow_hf + num_of_factors_hf};
+        T *d2_hf{d1_hf + num_of_factors_hf};
+        for (size_t k{0}; k < num_of_factors_hf; k++)
+        {
+            T x_hf{x_vars_hf[terms.x_idx[first_hf + k]]};
+            unsigned int exp_hf{terms.exps[first_hf + k]};
+            pow_hf[k] = int_pow(x_hf, exp_hf);
+            d1_hf[k] = T(exp_hf) * int_pow(x_hf, exp_hf - 1);
+            d2_hf[k] = (exp_hf < 2) ? T{0} : T(exp_hf) * T(exp_hf - 1) * int_pow(x_hf, exp_hf - 2);
+        }
+
+        // the factors of a term are sorted by x variable index, thus (a, b) with a <= b
+        // only touches the upper triangle of the hessian
+        for (size_t a{0}; a < num_of_factors_hf; a++)
+        {
+            for (size_t b{a}; b < num_of_factors_hf; b++)
+            {
+                // d^2/dx_i^2 (c * x_i^e * ...) = c * e*(e-1)*x_i^(e-2) * ...
+                // d^2/dx_i dx_j (c * x_i^e * x_j^f * ...) = c * e*x_i^(e-1) * f*x_j^(f-1) * ...
+                T entry_hf{terms.coeffs[term_idx_hf]};
+                entry_hf *= (a == b) ? d2_hf[a] : d1_hf[a] * d1_hf[b];
+                for (size_t k{0}; k < num_of_factors_hf; k++)
+                    if (k != a and k != b)
+                        entry_hf *= pow_hf[k];
+                hessian_mtx(terms.x_idx[first_hf + a], terms.x_idx[first_hf + b]) += entry_hf;
+            }
+        }
+    };
+
+    // mirror the upper triangle to the lower triangle
+    for (size_t row_idx_hf{1}; row_idx_hf < num_of_x_vars; row_idx_hf++)
+        for (size_t col_idx_hf{0}; col_idx_hf < row_idx_hf; col_idx_hf++)
+            hessian_mtx(row_idx_hf, col_idx_hf) = hessian_mtx(col_idx_hf, row_idx_hf);
+}
+
+template <typename T>
+void Polynomial<T>::hessian_vector_f(const vector<T> &x_vars_hvf, const vector<T> &vec_hvf, vector<T> &product_hvf,
+                                     vector<T> &scratch_hvf) const
+{
+    // if x_vars_hvf, vec_hvf or product_hvf has incorrect size
+    if (x_vars_hvf.size() != num_of_x_vars or vec_hvf.size() != num_of_x_vars or product_hvf.size() != num_of_x_vars)
         throw err_invalid_x_vector();
+    for (size_t x_idx_hvf{0}; x_idx_hvf < num_of_x_vars; x_idx_hvf++)
+        product_hvf[x_idx_hvf] = 0;
 
-    // consider the hessian matrix as the gradients of the current gradient gd_hf
-    for (size_t row_idx_hf{0}; row_idx_hf < num_of_x_vars; row_idx_hf++)
+    for (size_t term_idx_hvf{0}; term_idx_hvf < num_of_terms; term_idx_hvf++)
     {
-        vector<long double> curr_x_plus_h(num_of_x_vars, 0); // vector of x variables when x_i+h
-        curr_x_plus_h.at(row_idx_hf) = h;                    // [0, ..., 0, h, 0, ...]
-        curr_x_plus_h += x_vars_hf;                          // [x_1, ..., x_(i-1), (x_i)+h, x_(i+1), ...]
-        gd_gd_hf = gradient_f(curr_x_plus_h);                // update gradient of gradient
-        gd_gd_hf = 1.0L / h * (gd_gd_hf - gd_hf);            // vector/h -> 1/h*vector
-        for (size_t col_idx_hf{0}; col_idx_hf < num_of_x_vars; col_idx_hf++)
+        size_t first_hvf{terms.offsets[term_idx_hvf]};
+        size_t num_of_factors_hvf{terms.offsets[term_idx_hvf + 1] - first_hvf};
+        if (scratch_hvf.size() < 3 * num_of_factors_hvf)
+            scratch_hvf.resize(3 * num_of_factors_hvf);
+        // for each factor x_i^e of the current term store x_i^e, e*x_i^(e-1) and e*(e-1)*x_i^(e-2)
+        T *pow_hvf{scratch_hvf.data()};
+        T *d1_hvf{pow_hvf + num_of_factors_hvf};
+        T *d2_hvf{d1_hvf + num_of_factors_hvf};
+        for (size_t k{0}; k < num_of_factors_hvf; k++)
+        {
+            T x_hvf{x_vars_hvf[terms.x_idx[first_hvf + k]]};
+            unsigned int exp_hvf{terms.exps[first_hvf + k]};
+            pow_hvf[k] = int_pow(x_hvf, exp_hvf);
+            d1_hvf[k] = T(exp_hvf) * int_pow(x_hvf, exp_hvf - 1);
+            d2_hvf[k] = (exp_hvf < 2) ? T{0} : T(exp_hvf) * T(exp_hvf - 1) * int_pow(x_hvf, exp_hvf - 2);
+        }
+
+        // the same entries as hessian_f, each entry (i, j) of the upper triangle also stands for (j, i)
+        for (size_t a{0}; a < num_of_factors_hvf; a++)
         {
-            // since the hessian is calculated as the gradients of the current gradient
-            // the rounding error becomes significant
-            // round the values of hessian to 3 decimal places to reduce the effect
-            long double round_3{round(gd_gd_hf.at(col_idx_hf) * 1000) / 1000};
-            hessian_mtx(row_idx_hf, col_idx_hf) = round_3;
+            size_t row_hvf{terms.x_idx[first_hvf + a]};
+            for (size_t b{a}; b < num_of_factors_hvf; b++)
+            {
+                size_t col_hvf{terms.x_idx[first_hvf + b]};
+                T entry_hvf{terms.coeffs[term_idx_hvf]};
+                entry_hvf *= (a == b) ? d2_hvf[a] : d1_hvf[a] * d1_hvf[b];
+                for (size_t k{0}; k < num_of_factors_hvf; k++)
+                    if (k != a and k != b)
+                        entry_hvf *= pow_hvf[k];
+                product_hvf[row_hvf] += entry_hvf * vec_hvf[col_hvf];
+                if (a != b)
+                    product_hvf[col_hvf] += entry_hvf * vec_hvf[row_hvf];
+            }
         }
     };
-    return hessian_mtx;
 }
 
-matrix<long double> Polynomial::inverse_hessian_f(const vector<long double> &x_vars_ihf) const
+template <typename T>
+matrix<T> Polynomial<T>::inverse_hessian_f(const vector<T> &x_vars_ihf) const
 {
     return inverse_mtx(hessian_f(x_vars_ihf), num_of_x_vars);
 }
 
+// ======================================================================
+// Public member functions of Polynomial: batched evaluate functions
+// ======================================================================
+// see Polynomial.hpp for description
+
+template <typename T>
+void Polynomial<T>::eval_f_batch(const Point_Batch &points_efb, vector<double> &results_efb) const
+{
+    if (points_efb.get_num_of_x_vars() != num_of_x_vars)
+        throw err_invalid_x_vector();
+    size_t num_of_points_efb{points_efb.get_num_of_points()};
+    vector<double> term_buf_efb(num_of_points_efb), base_buf_efb(num_of_points_efb);
+    results_efb.resize(num_of_points_efb);
+    eval_terms_batch(terms, 0, num_of_terms, points_efb,
+                     results_efb.data(), term_buf_efb.data(), base_buf_efb.data());
+}
+
+template <typename T>
+void Polynomial<T>::gradient_f_batch(const Point_Batch &points_gfb, Point_Batch &gradients_gfb) const
+{
+    if (points_gfb.get_num_of_x_vars() != num_of_x_vars or gradients_gfb.get_num_of_x_vars() != num_of_x_vars or
+        points_gfb.get_num_of_points() != gradients_gfb.get_num_of_points())
+        throw err_invalid_x_vector();
+    size_t num_of_points_gfb{points_gfb.get_num_of_points()};
+    vector<double> term_buf_gfb(num_of_points_gfb), base_buf_gfb(num_of_points_gfb);
+    for (size_t x_idx_gfb{0}; x_idx_gfb < num_of_x_vars; x_idx_gfb++)
+    {
+        // the row of x_i in the gradient batch holds df/dx_i at every point
+        eval_terms_batch(df_terms, df_offsets[x_idx_gfb], df_offsets[x_idx_gfb + 1], points_gfb,
+                         gradients_gfb.x_values(x_idx_gfb), term_buf_gfb.data(), base_buf_gfb.data());
+    }
+}
+
 // ======================================================================
 // Private member functions of Polynomial: evaluate functions
 // ======================================================================
 // see Polynomial.hpp for description
 
-long double Polynomial::cofactor(const matrix<long double> &mtx_cof, const size_t &mtx_size_cof,
-                                 const size_t &remove_row_cof, const size_t &remove_col_cof) const
+template <typename T>
+T Polynomial<T>::eval_terms(const Sparse_Terms<T> &terms_et, const size_t &first_term_et,
+                                   const size_t &last_term_et, const vector<T> &x_vars_et) const
 {
-    // create a minor matrix based on the given matrix
-    matrix<long double> minor_mtx(mtx_size_cof - 1, mtx_size_cof - 1);
-    size_t minor_row_idx_{0};
-    // fill in the elements of the minor matrix
-    for (size_t row_idx_cof{0}; row_idx_cof < mtx_size_cof; row_idx_cof++)
+    T result_value{0}; // initialize the resulting value
+    for (size_t term_idx_et{first_term_et}; term_idx_et < last_term_et; term_idx_et++)
     {
-        size_t minor_col_idx_{0};
-        if (row_idx_cof == remove_row_cof)
-            continue;
-        for (size_t col_idx_cof{0}; col_idx_cof < mtx_size_cof; col_idx_cof++)
+        // term = coefficient * x_i^exponent * x_j^exponent * ..., only nonzero exponents are stored
+        T term_value{terms_et.coeffs[term_idx_et]};
+        for (size_t factor_idx_et{terms_et.offsets[term_idx_et]};
+             factor_idx_et < terms_et.offsets[term_idx_et + 1]; factor_idx_et++)
         {
-            if (col_idx_cof == remove_col_cof)
-                continue;
-            minor_mtx(minor_row_idx_, minor_col_idx_) = mtx_cof(row_idx_cof, col_idx_cof);
-            minor_col_idx_++;
-        };
-        minor_row_idx_++;
+            term_value *= int_pow(x_vars_et[terms_et.x_idx[factor_idx_et]], terms_et.exps[factor_idx_et]);
+        }
+        result_value += term_value;
     };
-    // return the cofactor based on the minor matrix
-    return pow(-1.0L, remove_row_cof + remove_col_cof) * determinant(minor_mtx, mtx_size_cof - 1);
+    return result_value;
 }
 
-long double Polynomial::determinant(const matrix<long double> &mtx_det,
-                                    const size_t &mtx_size_det) const
+template <typename T>
+matrix<T> Polynomial<T>::inverse_mtx(const matrix<T> &mtx_inv,
+                                            const size_t &mtx_size_inv) const
 {
-    long double det{0.0L};
-    matrix<long double> cof_mtx(mtx_size_det, mtx_size_det);
-
-    if (mtx_size_det == 1)
-        return mtx_det(0, 0);
-    if (mtx_size_det == 2)
-        return mtx_det(0, 0) * mtx_det(1, 1) - mtx_det(0, 1) * mtx_det(1, 0);
-    // find the determinant by applying the Laplace expansion
-    for (size_t row_idx_del{0}; row_idx_del < mtx_size_det; row_idx_del++)
+    matrix<T> return_mtx_inv(mtx_size_inv, mtx_size_inv);
+    matrix<T> lu_mtx_inv{mtx_inv};
+    vector<size_t> pivots_inv;
+    vector<T> col_inv(mtx_size_inv);
+    lu_factor(lu_mtx_inv, pivots_inv); // P*A = L*U
+    // column j of the inverse is the solution of A*x = e_j
+    for (size_t col_idx_inv{0}; col_idx_inv < mtx_size_inv; col_idx_inv++)
     {
-        det += mtx_det(row_idx_del, 0) * cofactor(mtx_det, mtx_size_det, row_idx_del, 0);
+        fill(col_inv.begin(), col_inv.end(), T{0});
+        col_inv[col_idx_inv] = T{1};
+        lu_solve(lu_mtx_inv, pivots_inv, col_inv);
+        for (size_t row_idx_inv{0}; row_idx_inv < mtx_size_inv; row_idx_inv++)
+            return_mtx_inv(row_idx_inv, col_idx_inv) = col_inv[row_idx_inv];
     }
-    return det;
+    return return_mtx_inv;
 }
 
-matrix<long double> Polynomial::adjugate_mtx(const matrix<long double> &mtx_adj,
-                                             const size_t &mtx_size_adj) const
+template <typename T>
+T Polynomial<T>::eval_horner(size_t node_idx_eh, const vector<T> &x_vars_eh) const
 {
-    matrix<long double> return_mtx_adj(mtx_size_adj, mtx_size_adj);
-    if (mtx_size_adj == 1)
+    T result_value{0};
+    // follow the chain of add_child nodes, recursion is only needed for mul_child
+    while (node_idx_eh != Horner_Node<T>::none)
     {
-        return_mtx_adj(0, 0) = 1.0L;
-        return return_mtx_adj;
+        const Horner_Node<T> &node_eh{horner_nodes[node_idx_eh]};
+        result_value += node_eh.constant;
+        if (node_eh.mul_child != Horner_Node<T>::none)
+            result_value += int_pow(x_vars_eh[node_eh.x_idx], node_eh.exp) * eval_horner(node_eh.mul_child, x_vars_eh);
+        node_idx_eh = node_eh.add_child;
     }
-    // create the adjugate matrix by finding the cofactor of each element
-    for (size_t row_idx_adj{0}; row_idx_adj < mtx_size_adj; row_idx_adj++)
-    {
-        for (size_t col_idx_adj{0}; col_idx_adj < mtx_size_adj; col_idx_adj++)
-        {
-            return_mtx_adj(row_idx_adj, col_idx_adj) = cofactor(mtx_adj, mtx_size_adj,
-                                                                col_idx_adj, row_idx_adj);
-        };
-    };
-    return return_mtx_adj;
+    return result_value;
 }
 
-matrix<long double> Polynomial::inverse_mtx(const matrix<long double> &mtx_inv,
-                                            const size_t &mtx_size_inv) const
+template <typename T>
+void Polynomial<T>::eval_terms_batch(const Sparse_Terms<T> &terms_etb, const size_t &first_term_etb,
+                                  const size_t &last_term_etb, const Point_Batch &points_etb,
+                                  double *results_etb, double *term_buf_etb, double *base_buf_etb) const
 {
-    matrix<long double> return_mtx_inv(mtx_size_inv, mtx_size_inv);
-    long double temp_det{determinant(mtx_inv, mtx_size_inv)};
-    return_mtx_inv = adjugate_mtx(mtx_inv, mtx_size_inv);
-    // Inverse A = 1/det(A) * adj(A)
-    return 1 / temp_det * return_mtx_inv;
+    size_t num_of_points_etb{points_etb.get_num_of_points()};
+    for (size_t point_idx{0}; point_idx < num_of_points_etb; point_idx++)
+        results_etb[point_idx] = 0.0;
+    for (size_t term_idx_etb{first_term_etb}; term_idx_etb < last_term_etb; term_idx_etb++)
+    {
+        double coeff_etb{static_cast<double>(terms_etb.coeffs[term_idx_etb])};
+        for (size_t point_idx{0}; point_idx < num_of_points_etb; point_idx++)
+            term_buf_etb[point_idx] = coeff_etb;
+        for (size_t factor_idx_etb{terms_etb.offsets[term_idx_etb]};
+             factor_idx_etb < terms_etb.offsets[term_idx_etb + 1]; factor_idx_etb++)
+        {
+            // repeated squaring with the same exponent for every point, so each step is one SIMD loop
+            const double *x_values_etb{points_etb.x_values(terms_etb.x_idx[factor_idx_etb])};
+            unsigned int exp_etb{terms_etb.exps[factor_idx_etb]};
+            for (size_t point_idx{0}; point_idx < num_of_points_etb; point_idx++)
+                base_buf_etb[point_idx] = x_values_etb[point_idx];
+            while (true)
+            {
+                if (exp_etb & 1U)
+                    for (size_t point_idx{0}; point_idx < num_of_points_etb; point_idx++)
+                        term_buf_etb[point_idx] *= base_buf_etb[point_idx];
+                exp_etb >>= 1;
+                if (exp_etb == 0)
+                    break;
+                for (size_t point_idx{0}; point_idx < num_of_points_etb; point_idx++)
+                    base_buf_etb[point_idx] *= base_buf_etb[point_idx];
+            }
+        }
+        for (size_t point_idx{0}; point_idx < num_of_points_etb; point_idx++)
+            results_etb[point_idx] += term_buf_etb[point_idx];
+    }
 }
+
+// ======================================================================
+// Explicit instantiations of Polynomial: evaluate functions
+// ======================================================================
+
+template float Polynomial<float>::eval_f(const vector<float> &) const;
+template float Polynomial<float>::eval_df(const vector<float> &, const size_t &) const;
+template vector<float> Polynomial<float>::gradient_f(const vector<float> &) const;
+template void Polynomial<float>::gradient_f(const vector<float> &, vector<float> &) const;
+template matrix<float> Polynomial<float>::hessian_f(const vector<float> &) const;
+template void Polynomial<float>::hessian_f(const vector<float> &, matrix<float> &, vector<float> &) const;
+template void Polynomial<float>::hessian_vector_f(const vector<float> &, const vector<float> &, vector<float> &,
+                                                  vector<float> &) const;
+template matrix<float> Polynomial<float>::inverse_hessian_f(const vector<float> &) const;
+template void Polynomial<float>::eval_f_batch(const Point_Batch &, vector<double> &) const;
+template void Polynomial<float>::gradient_f_batch(const Point_Batch &, Point_Batch &) const;
+
+template double Polynomial<double>::eval_f(const vector<double> &) const;
+template double Polynomial<double>::eval_df(const vector<double> &, const size_t &) const;
+template vector<double> Polynomial<double>::gradient_f(const vector<double> &) const;
+template void Polynomial<double>::gradient_f(const vector<double> &, vector<double> &) const;
+template matrix<double> Polynomial<double>::hessian_f(const vector<double> &) const;
+template void Polynomial<double>::hessian_f(const vector<double> &, matrix<double> &, vector<double> &) const;
+template void Polynomial<double>::hessian_vector_f(const vector<double> &, const vector<double> &, vector<double> &,
+                                                   vector<double> &) const;
+template matrix<double> Polynomial<double>::inverse_hessian_f(const vector<double> &) const;
+template void Polynomial<double>::eval_f_batch(const Point_Batch &, vector<double> &) const;
+template void Polynomial<double>::gradient_f_batch(const Point_Batch &, Point_Batch &) const;
+
+template long double Polynomial<long double>::eval_f(const vector<long double> &) const;
+template long double Polynomial<long double>::eval_df(const vector<long double> &, const size_t &) const;
+template vector<long double> Polynomial<long double>::gradient_f(const vector<long double> &) const;
+template void Polynomial<long double>::gradient_f(const vector<long double> &, vector<long double> &) const;
+template matrix<long double> Polynomial<long double>::hessian_f(const vector<long double> &) const;
+template void Polynomial<long double>::hessian_f(const vector<long double> &, matrix<long double> &, vector<long double> &) const;
+template void Polynomial<long double>::hessian_vector_f(const vector<long double> &, const vector<long double> &, vector<long double> &,
+                                                        vector<long double> &) const;
+template matrix<long double> Polynomial<long double>::inverse_hessian_f(const vector<long double> &) const;
+template void Polynomial<long double>::eval_f_batch(const Point_Batch &, vector<double> &) const;
+template void Polynomial<long double>::gradient_f_batch(const Point_Batch &, Point_Batch &) const;
@@ -1,6 +1,10 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <climits>
+#include <set>
+#include <utility>
 #include "Polynomial.hpp"
 #include "matrix.hpp"
 #include "Error_Handling.hpp"
@@ -12,8 +16,9 @@ using namespace std;
 // ======================================================================
 // see Polynomial.hpp for description
 
-Polynomial::Polynomial(const string &input_poly_str)
-    : poly_str(input_poly_str), num_of_x_vars(0), num_of_terms(1), coeff_exp_mtx(1, 1)
+template <typename T>
+Polynomial<T>::Polynomial(const string &input_poly_str)
+    : poly_str(input_poly_str), num_of_x_vars(0), num_of_terms(1)
 {
     size_t poly_str_length{poly_str.size()};
     string lhs_str{""};
@@ -29,6 +34,11 @@ Polynomial::Polynomial(const string &input_poly_str)
         throw err_missing_equal_sign{};
     check_valid_lhs_poly(lhs_str);
     check_valid_rhs_poly(rhs_str);
+    compile_derivatives();
+    compile_horner(terms);
+    // term by term: coefficient * x_i^e * x_j^f * ..., one multiplication per factor plus its power
+    for (unsigned int exp_p : terms.exps)
+        naive_mult_count += 1 + pow_mult_count(exp_p);
 }
 
 // ======================================================================
@@ -36,32 +46,64 @@ Polynomial::Polynomial(const string &input_poly_str)
 // ======================================================================
 // see Polynomial.hpp for description
 
-string Polynomial::get_poly_str() const
+template <typename T>
+string Polynomial<T>::get_poly_str() const
 {
     return poly_str;
 }
 
-size_t Polynomial::get_num_of_x_vars() const
+template <typename T>
+size_t Polynomial<T>::get_num_of_x_vars() const
 {
     return num_of_x_vars;
 }
 
-size_t Polynomial::get_num_of_terms() const
+template <typename T>
+size_t Polynomial<T>::get_num_of_terms() const
 {
     return num_of_terms;
 }
 
-matrix<long double> Polynomial::get_coeff_exp_mtx() const
+template <typename T>
+matrix<T> Polynomial<T>::get_coeff_exp_mtx() const
 {
+    // expand the sparse terms into the dense (num_of_terms, 1 + num_of_x_vars) matrix
+    matrix<T> coeff_exp_mtx(num_of_terms, 1 + num_of_x_vars);
+    for (size_t term_idx_gcem{0}; term_idx_gcem < num_of_terms; term_idx_gcem++)
+    {
+        coeff_exp_mtx(term_idx_gcem, 0) = terms.coeffs[term_idx_gcem];
+        for (size_t factor_idx_gcem{terms.offsets[term_idx_gcem]};
+             factor_idx_gcem < terms.offsets[term_idx_gcem + 1]; factor_idx_gcem++)
+            coeff_exp_mtx(term_idx_gcem, 1 + terms.x_idx[factor_idx_gcem]) = terms.exps[factor_idx_gcem];
+    }
     return coeff_exp_mtx;
 }
 
+template <typename T>
+const Sparse_Terms<T> &Polynomial<T>::get_terms() const
+{
+    return terms;
+}
+
+template <typename T>
+size_t Polynomial<T>::get_naive_mult_count() const
+{
+    return naive_mult_count;
+}
+
+template <typename T>
+size_t Polynomial<T>::get_horner_mult_count() const
+{
+    return horner_mult_count;
+}
+
 // ======================================================================
 // Overloaded operator of Polynomial
 // ======================================================================
 // see Polynomial.hpp for description
 
-ostream &operator<<(ostream &out, const Polynomial &poly)
+template <typename T>
+ostream &operator<<(ostream &out, const Polynomial<T> &poly)
 {
     out << poly.get_poly_str();
     return out;
@@ -72,7 +114,8 @@ ostream &operator<<(ostream &out, const Polynomial &poly)
 // ======================================================================
 // see Polynomial.hpp for description
 
-bool Polynomial::valid_non_negative_int(const string &int_str) const
+template <typename T>
+bool Polynomial<T>::valid_non_negative_int(const string &int_str) const
 {
     string valid_numbers{"1234567890"}; // valid characters of numbers
     if (int_str.size() == 0)
@@ -86,7 +129,8 @@ bool Polynomial::valid_non_negative_int(const string &int_str) const
     return true;
 }
 
-void Polynomial::check_valid_lhs_poly(const string &lhs_str_cvlp)
+template <typename T>
+void Polynomial<T>::check_valid_lhs_poly(const string &lhs_str_cvlp)
 {
     // lhs_str_len_cvlp stores the length of lhs_str_cvlp
     size_t lhs_str_len_cvlp{lhs_str_cvlp.size()};
@@ -141,7 +185,8 @@ void Polynomial::check_valid_lhs_poly(const string &lhs_str_cvlp)
     num_of_x_vars = curr_x_idx_cvlp - 1; // curr_x_idx_cvlp would count one more unit, thus reduce 1
 }
 
-void Polynomial::check_valid_rhs_poly(const string &rhs_str_cvrp)
+template <typename T>
+void Polynomial<T>::check_valid_rhs_poly(const string &rhs_str_cvrp)
 {
     size_t rhs_str_len_cvrp{rhs_str_cvrp.size()}; // store the length of rhs_str_cvrp
     string curr_term_str_cvrp{""};                // store the string of the current term
@@ -185,12 +230,12 @@ void Polynomial::check_valid_rhs_poly(const string &rhs_str_cvrp)
             terms_str_vec.at(curr_term_idx_cvrp_loop1) = curr_term_str_cvrp;
     }
 
-    // create a temporary matrix with size (num_of_terms, 1+num_of_x_vars),
-    // then assign it to the coeff_exp_mtx matrix, which is the private data of Polynomial
-    matrix<long double> temp_mtx(num_of_terms, 1 + num_of_x_vars);
-    coeff_exp_mtx = temp_mtx; // this process basically resizes coeff_exp_mtx
+    // start from empty sparse terms, which are the private data of Polynomial
+    terms = Sparse_Terms<T>{};
+    terms.coeffs.reserve(num_of_terms);
+    terms.offsets.reserve(num_of_terms + 1);
 
-    // now update the coeff_exp_mtx matrix based on the string vector terms_str_vec
+    // now compile the sparse terms based on the string vector terms_str_vec
     for (size_t curr_term_idx_cvrp_loop2{0}; // for each term in the num_of_terms
          curr_term_idx_cvrp_loop2 < num_of_terms; curr_term_idx_cvrp_loop2++)
     {
@@ -200,7 +245,9 @@ void Polynomial::check_valid_rhs_poly(const string &rhs_str_cvrp)
         if (curr_term_len_cvrp == 0)
             throw err_invalid_rhs_poly{};
         // default coefficient for a term is 1
-        coeff_exp_mtx(curr_term_idx_cvrp_loop2, 0) = 1;
+        T curr_coeff_cvrp{1};
+        // (x variable index, exponent) pairs of the current term, only a few x variables per term
+        vector<pair<size_t, size_t>> curr_factors_cvrp;
 
         // only the first character of each term can start with a '+' or '-' char
         if (curr_term_str_cvrp.at(0) == '+')
@@ -213,7 +260,7 @@ void Polynomial::check_valid_rhs_poly(const string &rhs_str_cvrp)
         if (curr_term_str_cvrp.at(0) == '-')
         {
             // default coefficient for a negative term becomes -1
-            coeff_exp_mtx(curr_term_idx_cvrp_loop2, 0) = -1;
+            curr_coeff_cvrp = -1;
             curr_term_len_cvrp--; // remove the first character '-'
             curr_term_str_cvrp = curr_term_str_cvrp.substr(1, curr_term_len_cvrp);
             if (curr_term_len_cvrp == 0) // check the term is not empty after removing '-'
@@ -258,11 +305,16 @@ void Polynomial::check_valid_rhs_poly(const string &rhs_str_cvrp)
                     // then we need to check the index of the x_variable is in num_of_x_vars
                     if ((0 < x_var_idx_ull) and (x_var_idx_ull <= num_of_x_vars))
                     {
-                        // only then we can store the x_variable's exponent in the coeff_exp_mtx
-                        coeff_exp_mtx(curr_term_idx_cvrp_loop2, x_var_idx_ull) += x_var_exp_ull;
-                        // this may cause loss of precision, since x_var_exp_ull is size_t,
-                        // while coeff_exp_mtx is a matrix of double, however the exponent of an x
-                        // variable shouldn't be extreme large, thus the loss is unlikely to happen
+                        // only then we can store the x_variable's exponent in the current term,
+                        // the same x variable may appear more than once, ex: x_1*x_1 = x_1^2
+                        auto same_x_var{find_if(curr_factors_cvrp.begin(), curr_factors_cvrp.end(),
+                                                [&](const pair<size_t, size_t> &factor) {
+                                                    return factor.first == x_var_idx_ull - 1;
+                                                })};
+                        if (same_x_var == curr_factors_cvrp.end())
+                            curr_factors_cvrp.push_back({x_var_idx_ull - 1, x_var_exp_ull});
+                        else
+                            same_x_var->second += x_var_exp_ull;
                     }
                     else // x_variable is either x_0 or more than num_of_x_vars
                         throw err_invalid_rhs_poly{};
@@ -276,7 +328,7 @@ void Polynomial::check_valid_rhs_poly(const string &rhs_str_cvrp)
                 if (dec_point_idx == string::npos)         // didn't find '.' -> expect an integer
                 {
                     if (valid_non_negative_int(curr_elem)) // curr_elem is a non-negative integer
-                        coeff_exp_mtx(curr_term_idx_cvrp_loop2, 0) *= stod(curr_elem);
+                        curr_coeff_cvrp *= static_cast<T>(stold(curr_elem));
                     else // curr_elem does not have a decimal point and is not a non-negative integer
                         throw err_invalid_rhs_poly{};
                 }
@@ -289,12 +341,231 @@ void Polynomial::check_valid_rhs_poly(const string &rhs_str_cvrp)
                         valid_non_negative_int(after_dec_point_str))
                     {
                         // curr_elem is composed of "non_negative_int + '.' + non_negative_int"
-                        coeff_exp_mtx(curr_term_idx_cvrp_loop2, 0) *= stod(curr_elem);
+                        curr_coeff_cvrp *= static_cast<T>(stold(curr_elem));
                     }
                     else
                         throw err_invalid_rhs_poly{};
                 };
             }
         }
+
+        // store the current term, the factors are sorted by x variable index and
+        // x variables with a zero exponent (ex: x_1^0) are dropped
+        sort(curr_factors_cvrp.begin(), curr_factors_cvrp.end());
+        terms.coeffs.push_back(curr_coeff_cvrp);
+        for (const pair<size_t, size_t> &curr_factor : curr_factors_cvrp)
+        {
+            if (curr_factor.second == 0)
+                continue;
+            if (curr_factor.second > UINT_MAX) // exponent is too large to be stored
+                throw err_invalid_rhs_poly{};
+            terms.x_idx.push_back(curr_factor.first);
+            terms.exps.push_back(static_cast<unsigned int>(curr_factor.second));
+        }
+        terms.offsets.push_back(terms.x_idx.size());
     }
 }
+
+template <typename T>
+void Polynomial<T>::compile_derivatives()
+{
+    size_t num_of_factors_cd{terms.x_idx.size()};
+
+    // each factor x_i^e of a term contributes one term to df/dx_i,
+    // so first count the derivative terms of each x variable
+    df_offsets.assign(num_of_x_vars + 1, 0);
+    for (size_t x_idx_cd : terms.x_idx)
+        df_offsets[x_idx_cd + 1]++;
+    for (size_t x_idx_cd{0}; x_idx_cd < num_of_x_vars; x_idx_cd++)
+        df_offsets[x_idx_cd + 1] += df_offsets[x_idx_cd];
+
+    // then group the factors by x variable, storing the term and the factor they come from
+    vector<size_t> next_slot_cd(df_offsets.begin(), df_offsets.end() - 1);
+    vector<size_t> src_term_cd(num_of_factors_cd);
+    vector<size_t> src_factor_cd(num_of_factors_cd);
+    for (size_t term_idx_cd{0}; term_idx_cd < num_of_terms; term_idx_cd++)
+    {
+        for (size_t factor_idx_cd{terms.offsets[term_idx_cd]};
+             factor_idx_cd < terms.offsets[term_idx_cd + 1]; factor_idx_cd++)
+        {
+            size_t slot_cd{next_slot_cd[terms.x_idx[factor_idx_cd]]++};
+            src_term_cd[slot_cd] = term_idx_cd;
+            src_factor_cd[slot_cd] = factor_idx_cd;
+        }
+    }
+
+    // finally apply the power rule: d/dx_i (c * x_i^e * ...) = (c * e) * x_i^(e-1) * ...
+    df_terms = Sparse_Terms<T>{};
+    df_terms.coeffs.reserve(num_of_factors_cd);
+    df_terms.offsets.reserve(num_of_factors_cd + 1);
+    for (size_t slot_cd{0}; slot_cd < num_of_factors_cd; slot_cd++)
+    {
+        size_t term_idx_cd{src_term_cd[slot_cd]};
+        size_t diff_factor_cd{src_factor_cd[slot_cd]};
+        df_terms.coeffs.push_back(terms.coeffs[term_idx_cd] * terms.exps[diff_factor_cd]);
+        for (size_t factor_idx_cd{terms.offsets[term_idx_cd]};
+             factor_idx_cd < terms.offsets[term_idx_cd + 1]; factor_idx_cd++)
+        {
+            unsigned int exp_cd{terms.exps[factor_idx_cd]};
+            if (factor_idx_cd == diff_factor_cd)
+                exp_cd--;
+            if (exp_cd == 0) // x_i^0 = 1 is not stored
+                continue;
+            df_terms.x_idx.push_back(terms.x_idx[factor_idx_cd]);
+            df_terms.exps.push_back(exp_cd);
+        }
+        df_terms.offsets.push_back(df_terms.x_idx.size());
+    }
+}
+
+template <typename T>
+size_t Polynomial<T>::compile_horner(const Sparse_Terms<T> &terms_ch)
+{
+    size_t first_node_ch{horner_nodes.size()};
+    horner_nodes.push_back(Horner_Node<T>{});
+    size_t num_of_terms_ch{terms_ch.coeffs.size()};
+
+    // the constant terms are added to the first node, the other nodes of the chain only have non-constant terms
+    T constant_ch{0};
+    for (size_t term_idx_ch{0}; term_idx_ch < num_of_terms_ch; term_idx_ch++)
+    {
+        if (terms_ch.offsets[term_idx_ch] == terms_ch.offsets[term_idx_ch + 1])
+            constant_ch += terms_ch.coeffs[term_idx_ch];
+    }
+    horner_nodes[first_node_ch].constant = constant_ch;
+    if (terms_ch.x_idx.empty()) // only constant terms
+        return first_node_ch;
+
+    // the distinct x variables of the terms (sorted), each factor refers to its x variable by its rank in vars_ch
+    vector<size_t> vars_ch{terms_ch.x_idx};
+    sort(vars_ch.begin(), vars_ch.end());
+    vars_ch.erase(unique(vars_ch.begin(), vars_ch.end()), vars_ch.end());
+    size_t num_of_factors_ch{terms_ch.x_idx.size()};
+    vector<size_t> factor_var_ch(num_of_factors_ch);
+    vector<size_t> factor_term_ch(num_of_factors_ch);
+    // the factors of each x variable in ascending order of their terms, in CSR form
+    vector<size_t> var_offsets_ch(vars_ch.size() + 1, 0);
+    for (size_t term_idx_ch{0}; term_idx_ch < num_of_terms_ch; term_idx_ch++)
+        for (size_t factor_idx_ch{terms_ch.offsets[term_idx_ch]};
+             factor_idx_ch < terms_ch.offsets[term_idx_ch + 1]; factor_idx_ch++)
+        {
+            size_t var_ch{static_cast<size_t>(lower_bound(vars_ch.begin(), vars_ch.end(), terms_ch.x_idx[factor_idx_ch]) -
+                                              vars_ch.begin())};
+            factor_var_ch[factor_idx_ch] = var_ch;
+            factor_term_ch[factor_idx_ch] = term_idx_ch;
+            var_offsets_ch[var_ch + 1]++;
+        }
+    for (size_t var_ch{0}; var_ch < vars_ch.size(); var_ch++)
+        var_offsets_ch[var_ch + 1] += var_offsets_ch[var_ch];
+    vector<size_t> var_factors_ch(num_of_factors_ch);
+    vector<size_t> next_slot_ch(var_offsets_ch.begin(), var_offsets_ch.end() - 1);
+    for (size_t factor_idx_ch{0}; factor_idx_ch < num_of_factors_ch; factor_idx_ch++)
+        var_factors_ch[next_slot_ch[factor_var_ch[factor_idx_ch]]++] = factor_idx_ch;
+
+    // number of terms of each x variable that are not yet in a quotient (each x variable appears once per term),
+    // ranked by the most terms first, ties are broken by the smaller index
+    auto ranked_first = [](const pair<size_t, size_t> &a, const pair<size_t, size_t> &b) {
+        return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second);
+    };
+    set<pair<size_t, size_t>, decltype(ranked_first)> ranking_ch(ranked_first);
+    vector<size_t> counts_ch(vars_ch.size());
+    for (size_t var_ch{0}; var_ch < vars_ch.size(); var_ch++)
+    {
+        counts_ch[var_ch] = var_offsets_ch[var_ch + 1] - var_offsets_ch[var_ch];
+        ranking_ch.insert({counts_ch[var_ch], var_ch});
+    }
+    vector<bool> in_quotient_ch(num_of_terms_ch, false);
+
+    // the chain of add_child nodes is built in a loop, only mul_child needs recursion,
+    // thus the recursion depth is at most the degree of the polynomial.
+    // Each term is moved to a quotient once, thus the chain costs O(nnz log nnz) instead of O(n * nnz)
+    size_t curr_node_ch{first_node_ch};
+    while (true)
+    {
+        size_t best_var_ch{ranking_ch.begin()->second};
+        size_t var_first_ch{var_offsets_ch[best_var_ch]}, var_last_ch{var_offsets_ch[best_var_ch + 1]};
+        unsigned int min_exp_ch{UINT_MAX};
+        for (size_t slot_ch{var_first_ch}; slot_ch < var_last_ch; slot_ch++)
+            if (!in_quotient_ch[factor_term_ch[var_factors_ch[slot_ch]]])
+                min_exp_ch = min(min_exp_ch, terms_ch.exps[var_factors_ch[slot_ch]]);
+
+        // the terms with the x variable are x^min_exp * quotient, the others are left for the rest of the chain
+        Sparse_Terms<T> quotient_ch;
+        for (size_t slot_ch{var_first_ch}; slot_ch < var_last_ch; slot_ch++)
+        {
+            size_t term_idx_ch{factor_term_ch[var_factors_ch[slot_ch]]};
+            if (in_quotient_ch[term_idx_ch])
+                continue;
+            in_quotient_ch[term_idx_ch] = true;
+            quotient_ch.coeffs.push_back(terms_ch.coeffs[term_idx_ch]);
+            for (size_t factor_idx_ch{terms_ch.offsets[term_idx_ch]};
+                 factor_idx_ch < terms_ch.offsets[term_idx_ch + 1]; factor_idx_ch++)
+            {
+                // the term leaves the rest of the chain, update the count of its x variables
+                size_t var_ch{factor_var_ch[factor_idx_ch]};
+                ranking_ch.erase({counts_ch[var_ch], var_ch});
+                if (--counts_ch[var_ch] > 0)
+                    ranking_ch.insert({counts_ch[var_ch], var_ch});
+
+                unsigned int exp_ch{terms_ch.exps[factor_idx_ch]};
+                if (var_ch == best_var_ch)
+                    exp_ch -= min_exp_ch;
+                if (exp_ch == 0)
+                    continue;
+                quotient_ch.x_idx.push_back(terms_ch.x_idx[factor_idx_ch]);
+                quotient_ch.exps.push_back(exp_ch);
+            }
+            quotient_ch.offsets.push_back(quotient_ch.x_idx.size());
+        }
+
+        // x^min_exp * quotient costs the power and one more multiplication
+        size_t mul_child_ch{compile_horner(quotient_ch)};
+        horner_nodes[curr_node_ch].x_idx = vars_ch[best_var_ch];
+        horner_nodes[curr_node_ch].exp = min_exp_ch;
+        horner_nodes[curr_node_ch].mul_child = mul_child_ch;
+        horner_mult_count += 1 + pow_mult_count(min_exp_ch);
+        if (ranking_ch.empty()) // every non-constant term is in a quotient
+            break;
+
+        // continue the chain with the terms that are not in a quotient
+        size_t next_node_ch{horner_nodes.size()};
+        horner_nodes.push_back(Horner_Node<T>{});
+        horner_nodes[curr_node_ch].add_child = next_node_ch;
+        curr_node_ch = next_node_ch;
+    }
+    return first_node_ch;
+}
+
+// ======================================================================
+// Explicit instantiations of Polynomial: validate polynomial string
+// ======================================================================
+
+template Polynomial<float>::Polynomial(const string &);
+template string Polynomial<float>::get_poly_str() const;
+template size_t Polynomial<float>::get_num_of_x_vars() const;
+template size_t Polynomial<float>::get_num_of_terms() const;
+template matrix<float> Polynomial<float>::get_coeff_exp_mtx() const;
+template const Sparse_Terms<float> &Polynomial<float>::get_terms() const;
+template size_t Polynomial<float>::get_naive_mult_count() const;
+template size_t Polynomial<float>::get_horner_mult_count() const;
+template ostream &operator<<(ostream &, const Polynomial<float> &);
+
+template Polynomial<double>::Polynomial(const string &);
+template string Polynomial<double>::get_poly_str() const;
+template size_t Polynomial<double>::get_num_of_x_vars() const;
+template size_t Polynomial<double>::get_num_of_terms() const;
+template matrix<double> Polynomial<double>::get_coeff_exp_mtx() const;
+template const Sparse_Terms<double> &Polynomial<double>::get_terms() const;
+template size_t Polynomial<double>::get_naive_mult_count() const;
+template size_t Polynomial<double>::get_horner_mult_count() const;
+template ostream &operator<<(ostream &, const Polynomial<double> &);
+
+template Polynomial<long double>::Polynomial(const string &);
+template string Polynomial<long double>::get_poly_str() const;
+template size_t Polynomial<long double>::get_num_of_x_vars() const;
+template size_t Polynomial<long double>::get_num_of_terms() const;
+template matrix<long double> Polynomial<long double>::get_coeff_exp_mtx() const;
+template const Sparse_Terms<long double> &Polynomial<long double>::get_terms() const;
+template size_t Polynomial<long double>::get_naive_mult_count() const;
+template size_t Polynomial<long double>::get_horner_mult_count() const;
+template ostream &operator<<(ostream &, const Polynomial<long double> &);
@@ -21,6 +21,7 @@
 #include <chrono>
 #include <cmath>
 #include "Input_Data.hpp"
+#include "Solver_Workspace.hpp"
 #include "matrix.hpp"
 #include "vector_overloads.hpp"
 #include "Error_Handling.hpp"
@@ -29,7 +30,9 @@ using namespace std;
 
 /**
  * @brief A class for result handling
+ * @tparam T The scalar type of the Input_Data
  */
+template <typename T>
 class Result_Handling
 {
 public:
@@ -39,18 +42,21 @@ public:
 
     /**
      * @brief Construct a new Result_Handling object
-     * @param input An Input_Data class that stores the input data from input_function.txt
+     * @param input An Input_Data class that stores the input data from input_function.txt,
+     * it is not modified, thus several Result_Handling objects can be constructed at the same time on different threads
      * @param algorithm_str A string representation of the optimization algorithm to perform
      * @throws err_fail_to_read_results_txt if the program fails to open the output file(s) output_results
-     * @throws err_unknown_algorithm if the input algorithm string is not "gradient_descent" or "newtons_method"
+     * @throws err_unknown_algorithm if the input algorithm string is not one of algorithm_names (see Algorithm_Options.hpp)
      * 
      * @details The constructor implements the corresponding algorithm and record its runtime,
      * then it stores all the results from the optimization algorithm to separate text files
      * in the current workspace folder
      */
-    Result_Handling(Input_Data &input, const string &algorithm_str)
+    Result_Handling(const Input_Data<T> &input, const string &algorithm_str)
     {
         int case_num{0};
+        vector<T> x_current;             // the current x when the algorithm stops
+        size_t dropped_trace_records{0}; // the iteration records dropped by the trace of the algorithm
         chrono::duration<double> elapsed_time_seconds{0};
 
         ofstream store_results{"output_results_" + algorithm_str + ".txt"};
@@ -58,55 +64,96 @@ public:
             throw err_fail_to_read_results_txt();
 
         if (algorithm_str == "gradient_descent")
-        {
             store_results << "========== Gradient Descent/Ascent Results =========="
                           << "\n\n";
-            // time the algorithm
-            chrono::time_point start_time{chrono::steady_clock::now()};
-            case_num = input.gradient_descent();
-            chrono::time_point end_time{chrono::steady_clock::now()};
-            elapsed_time_seconds = end_time - start_time;
-        }
         else if (algorithm_str == "newtons_method")
-        {
             store_results << "========== Newton's Method Results =========="
                           << "\n\n";
-            // time the algorithm
-            chrono::time_point start_time{chrono::steady_clock::now()};
-            case_num = input.newtons_method();
-            chrono::time_point end_time{chrono::steady_clock::now()};
-            elapsed_time_seconds = end_time - start_time;
-        }
+        else if (algorithm_str == "lbfgs")
+            store_results << "========== L-BFGS Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "bfgs")
+            store_results << "========== BFGS Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "conjugate_gradient")
+            store_results << "========== Nonlinear Conjugate Gradient Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "trust_region")
+            store_results << "========== Trust-Region Newton-CG Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "levenberg_marquardt")
+            store_results << "========== Levenberg-Marquardt Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "shamanskii")
+            store_results << "========== Shamanskii (Modified Newton) Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "barzilai_borwein")
+            store_results << "========== Barzilai-Borwein (Spectral Gradient) Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "nesterov")
+            store_results << "========== Nesterov Accelerated Gradient Results =========="
+                          << "\n\n";
+        else if (algorithm_str == "adam")
+            store_results << "========== Adam Results =========="
+                          << "\n\n";
         else
         {
-            // algorithm other than gradient_descent or newtons_method is entered
+            // algorithm other than the ones in algorithm_names is entered
             store_results.close();
             throw err_unknown_algorithm();
         }
 
+        // time the algorithm
+        Solver_Workspace<T> workspace(input.get_polynomial());
+        chrono::time_point start_time{chrono::steady_clock::now()};
+        case_num = input.run_algorithm(algorithm_str, x_current, dropped_trace_records, workspace);
+        chrono::time_point end_time{chrono::steady_clock::now()};
+        elapsed_time_seconds = end_time - start_time;
+
         store_results << "min/max: " << input.get_min_max() << '\n';
         store_results << input.get_polynomial() << '\n';
         store_results << "initial_point: " << input.get_x_initial();
         store_results << "tolerance: " << input.get_tolerance() << '\n';
         store_results << "max_iter: " << input.get_max_iter() << '\n';
+        if (algorithm_str == "lbfgs")
+            store_results << "lbfgs_memory: " << input.get_algorithm_options().lbfgs_memory << '\n';
+        if (algorithm_str == "bfgs")
+            store_results << "bfgs_reset: " << input.get_algorithm_options().bfgs_reset << '\n';
+        if (algorithm_str == "conjugate_gradient")
+            store_results << "cg_formula: " << input.get_algorithm_options().cg_formula << '\n';
+        if (algorithm_str == "shamanskii")
+            store_results << "refactor_interval: " << input.get_algorithm_options().refactor_interval << '\n';
+        if (algorithm_str == "barzilai_borwein")
+            store_results << "nonmonotone_memory: " << input.get_algorithm_options().nonmonotone_memory << '\n';
+        if (algorithm_str == "nesterov" or algorithm_str == "adam")
+            store_results << "learning_rate: " << input.get_algorithm_options().learning_rate << '\n';
         store_results << "coeff_exp_mtx:" << '\n';
         store_results << input.get_polynomial().get_coeff_exp_mtx();
+        store_results << "eval_f multiplications: " << input.get_polynomial().get_horner_mult_count()
+                      << " (Horner form), " << input.get_polynomial().get_naive_mult_count()
+                      << " (term by term)" << "\n\n";
 
         store_results << "The algorithm took " << elapsed_time_seconds.count() << " seconds"
                       << "\n\n";
+        if (algorithm_str == "shamanskii")
+            store_results << "Hessian factorizations: " << workspace.num_of_factorizations
+                          << ", skipped (reused factorization): " << workspace.num_of_skipped_factorizations << "\n\n";
+        if (dropped_trace_records > 0)
+            store_results << "Dropped iteration records (trace_policy=drop): "
+                          << dropped_trace_records << "\n\n";
 
         // to improve readability, round the values of the current x point to 3 decimal places
-        vector<long double> x_round_3{input.get_x_current()};
+        vector<T> x_round_3{x_current};
         for_each(x_round_3.begin(), x_round_3.end(),
-                 [](long double &n) { n = round(n * 1000) / 1000; });
+                 [](T &n) { n = round(n * 1000) / 1000; });
 
         switch (case_num)
         {
         case 1:
             // Case # 1: the current x point is now updated to a stationary point
             store_results << "Case 1:" << endl;
-            if (algorithm_str == "newtons_method")
-                // Newton's method can only be used to find a stationary point
+            if (algorithm_str == "newtons_method" or algorithm_str == "shamanskii")
+                // Newton's method (and its modification) can only be used to find a stationary point
                 store_results << "A stationary point is found at: ";
             else if (input.get_min_max() == 1)
                 store_results << "A local maximum is found at: ";
@@ -132,6 +179,24 @@ public:
             store_results << "This might suggest that there is no stationary point around the initial point," << endl;
             store_results << "or that the current x values are too large/small." << endl;
             break;
+        case 4:
+            // Case # 4: the hessian of the current point is singular,
+            //           algorithm is stopped since the newton direction does not exist
+            store_results << "Case 4:" << endl;
+            store_results << "The hessian of the current point is singular," << endl;
+            store_results << "The algorithm is stopped since the newton direction does not exist," << endl;
+            store_results << "The current point is at: " << x_round_3;
+            store_results << "Please try a different initial point." << endl;
+            break;
+        case 6:
+            // Case # 6: the step no longer moves the current x point,
+            //           algorithm is stopped since f cannot be improved at the precision of the scalar type
+            store_results << "Case 6:" << endl;
+            store_results << "The step no longer moves the current point," << endl;
+            store_results << "The algorithm is stopped since f cannot be improved at this precision," << endl;
+            store_results << "The current point is at: " << x_round_3;
+            store_results << "Please try a larger tolerance or a higher precision." << endl;
+            break;
         default:
             // failed to perform the optimization algorithm
             store_results << "Failed to perform the optimization algorithm, please check the input polynomial" << endl;
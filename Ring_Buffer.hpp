@@ -0,0 +1,115 @@
+/**
+ * @file Ring_Buffer.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A lock-free single-producer single-consumer Ring_Buffer class
+ *
+ * @details This library contains a class template Ring_Buffer used by Iteration_Trace to pass
+ * iteration records from the optimization thread to the writer thread. <br>
+ * The slots are allocated once in the constructor and reused, the producer fills a slot in place
+ * (try_acquire, then publish) and the consumer reads it in place (front, then pop),
+ * so passing a record does not allocate memory. Exactly one thread may produce and exactly one thread may consume
+ */
+
+#pragma once
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief A class for a single-producer single-consumer ring buffer
+ * @tparam S The type of a slot
+ */
+template <typename S>
+class Ring_Buffer
+{
+public:
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Ring_Buffer object
+     * @param input_capacity The number of slots (at least 1)
+     * @param prototype_slot Every slot is initialized to a copy of it, so slots holding vectors are presized
+     */
+    Ring_Buffer(const size_t &input_capacity, const S &prototype_slot)
+        : capacity(input_capacity == 0 ? 1 : input_capacity), slots(capacity, prototype_slot) {}
+
+    // ======================================================================
+    // Public member functions of Ring_Buffer: producer
+    // ======================================================================
+
+    /**
+     * @brief Public member function used by the producer to obtain the next free slot
+     * @return S* A pointer to the free slot, or nullptr if the ring buffer is full
+     */
+    S *try_acquire()
+    {
+        size_t head_ta{head.load(memory_order_relaxed)};
+        // only read the tail of the consumer (another cache line) when the cached one says the buffer is full
+        if (head_ta - cached_tail == capacity)
+        {
+            cached_tail = tail.load(memory_order_acquire);
+            if (head_ta - cached_tail == capacity)
+                return nullptr;
+        }
+        return &slots[head_ta % capacity];
+    }
+
+    /**
+     * @brief Public member function used by the producer to hand the slot from try_acquire to the consumer
+     */
+    void publish()
+    {
+        head.store(head.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+
+    // ======================================================================
+    // Public member functions of Ring_Buffer: consumer
+    // ======================================================================
+
+    /**
+     * @brief Public member function used by the consumer to obtain the oldest published slot
+     * @return const S* A pointer to the slot, or nullptr if the ring buffer is empty
+     */
+    const S *front()
+    {
+        size_t tail_f{tail.load(memory_order_relaxed)};
+        // only read the head of the producer (another cache line) when the cached one says the buffer is empty
+        if (cached_head == tail_f)
+        {
+            cached_head = head.load(memory_order_acquire);
+            if (cached_head == tail_f)
+                return nullptr;
+        }
+        return &slots[tail_f % capacity];
+    }
+
+    /**
+     * @brief Public member function used by the consumer to hand the slot from front back to the producer
+     */
+    void pop()
+    {
+        tail.store(tail.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+
+private:
+    // ======================================================================
+    // Private data of Ring_Buffer
+    // ======================================================================
+
+    size_t capacity; // number of slots
+    vector<S> slots; // slot i holds the records i, i + capacity, i + 2 * capacity, ...
+
+    // the counters only increase, head - tail is the number of published slots,
+    // they are kept on separate cache lines so the two threads do not invalidate each other
+    alignas(64) atomic<size_t> head{0}; // number of slots published by the producer
+    size_t cached_tail{0};              // last tail seen by the producer, only used by the producer
+    alignas(64) atomic<size_t> tail{0}; // number of slots popped by the consumer
+    size_t cached_head{0};              // last head seen by the consumer, only used by the consumer
+};
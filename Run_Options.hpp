@@ -0,0 +1,346 @@
+/**
+ * @file Run_Options.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ * 
+ * @brief A Run_Options class that validates and stores the command line options of the program
+ * 
+ * @details Options are given on the command line as key=value pairs, for example:
+ * "./optimize precision=double trace_stride=100". Options that are not given keep their default values
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Algorithm_Options.hpp"
+#include "Iteration_Trace.hpp"
+#include "Multi_Start.hpp"
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+/**
+ * @brief A class for the command line options
+ */
+class Run_Options
+{
+public:
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Run_Options object from the command line arguments
+     * @param argc The number of command line arguments
+     * @param argv The command line arguments, argv[0] is the name of the program
+     * @throws err_invalid_option if an option is unknown or has an invalid value
+     */
+    Run_Options(int argc, char *argv[])
+    {
+        for (int arg_idx{1}; arg_idx < argc; arg_idx++)
+        {
+            string option_str{argv[arg_idx]};
+            size_t equal_sign_idx{option_str.find('=')};
+            if (equal_sign_idx == string::npos)
+                throw err_invalid_option();
+            string key_str{option_str.substr(0, equal_sign_idx)};
+            string value_str{option_str.substr(equal_sign_idx + 1)};
+
+            if (key_str == "precision")
+            {
+                // scalar type used by the polynomial and the optimization algorithms
+                if (value_str != "float" and value_str != "double" and value_str != "long_double")
+                    throw err_invalid_option();
+                precision = value_str;
+            }
+            else if (key_str == "trace_format")
+            {
+                // format of the output_iterations files, see Iteration_Trace.hpp
+                if (value_str != "binary" and value_str != "text" and value_str != "none")
+                    throw err_invalid_option();
+                trace_options.format = value_str;
+            }
+            else if (key_str == "trace_stride")
+                // store every k-th iteration, k must be a positive integer
+                trace_options.stride = positive_integer(value_str);
+            else if (key_str == "trace_buffer")
+                // maximum number of records the ring buffer of the trace writer holds,
+                // fewer if the records of a large polynomial would take more than 16 MB (see Iteration_Trace.hpp)
+                trace_options.buffer_size = positive_integer(value_str);
+            else if (key_str == "trace_policy")
+            {
+                // what to do when the trace writer falls behind: wait for it or drop records
+                if (value_str != "block" and value_str != "drop")
+                    throw err_invalid_option();
+                trace_options.drop_when_full = (value_str == "drop");
+            }
+            else if (key_str == "mode")
+            {
+                // run once from initial_point, from many initial points (see Multi_Start.hpp),
+                // race the algorithms from initial_point (see Algorithm_Race.hpp)
+                // or solve every problem of a batch file (see Batch_Solver.hpp)
+                if (value_str != "single" and value_str != "multi_start" and value_str != "race" and value_str != "batch")
+                    throw err_invalid_option();
+                mode = value_str;
+            }
+            else if (key_str == "batch_file")
+            {
+                // file of problems of the batch mode
+                if (value_str.empty())
+                    throw err_invalid_option();
+                batch_file = value_str;
+            }
+            else if (key_str == "starts_file")
+            {
+                // file of initial points of the multi-start mode, one point per line
+                if (value_str.empty())
+                    throw err_invalid_option();
+                multi_start_options.starts_file = value_str;
+            }
+            else if (key_str == "sampling")
+            {
+                // how the multi-start mode samples its initial points if there is no starts_file
+                if (value_str != "sobol" and value_str != "lhs")
+                    throw err_invalid_option();
+                multi_start_options.sampling = value_str;
+            }
+            else if (key_str == "num_starts")
+                multi_start_options.num_of_starts = positive_integer(value_str);
+            else if (key_str == "box_lower")
+                multi_start_options.box_lower = real_number(value_str);
+            else if (key_str == "box_upper")
+                multi_start_options.box_upper = real_number(value_str);
+            else if (key_str == "seed")
+                multi_start_options.seed = positive_integer(value_str);
+            else if (key_str == "screen_starts")
+                // number of initial points with the best f that the multi-start mode runs the algorithms from
+                multi_start_options.num_of_screened_starts = positive_integer(value_str);
+            else if (key_str == "threads")
+                num_of_threads = positive_integer(value_str);
+            else if (key_str == "multi_start_algorithm")
+            {
+                // algorithms run from every initial point of the multi-start mode
+                if (value_str == "both")
+                    multi_start_options.algorithms = {"gradient_descent", "newtons_method"};
+                else if (is_algorithm_name(value_str))
+                    multi_start_options.algorithms = {value_str};
+                else
+                    throw err_invalid_option();
+            }
+            else if (key_str == "algorithms")
+                // algorithms performed by the single, race and batch modes
+                algorithms = algorithm_list(value_str);
+            else if (key_str == "lbfgs_memory")
+                // number of (s, y) pairs stored by lbfgs
+                algorithm_options.lbfgs_memory = positive_integer(value_str);
+            else if (key_str == "bfgs_reset")
+            {
+                // how bfgs resets its inverse hessian when the curvature condition fails
+                if (value_str != "none" and value_str != "identity" and value_str != "hessian")
+                    throw err_invalid_option();
+                algorithm_options.bfgs_reset = value_str;
+            }
+            else if (key_str == "cg_formula")
+            {
+                // formula of beta of conjugate_gradient
+                if (value_str != "pr_plus" and value_str != "hager_zhang")
+                    throw err_invalid_option();
+                algorithm_options.cg_formula = value_str;
+            }
+            else if (key_str == "refactor_interval")
+                // maximum number of iterations of shamanskii that reuse the same factorization of the hessian
+                algorithm_options.refactor_interval = positive_integer(value_str);
+            else if (key_str == "nonmonotone_memory")
+                // number of recent values of f used by the nonmonotone line search of barzilai_borwein
+                algorithm_options.nonmonotone_memory = positive_integer(value_str);
+            else if (key_str == "learning_rate")
+            {
+                // fixed step size of nesterov and adam, it must be positive
+                algorithm_options.learning_rate = real_number(value_str);
+                if (!(algorithm_options.learning_rate > 0))
+                    throw err_invalid_option();
+            }
+            else
+                throw err_invalid_option();
+        }
+        // the sampling box must not be empty
+        if (!(multi_start_options.box_lower < multi_start_options.box_upper))
+            throw err_invalid_option();
+    }
+
+    // ======================================================================
+    // Public member functions of Run_Options: get values
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the precision option
+     * @return string "float", "double" or "long_double"
+     */
+    string get_precision() const
+    {
+        return precision;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the trace options
+     * (trace_format, trace_stride, trace_buffer and trace_policy)
+     * @return Trace_Options The options of the iteration traces, see Iteration_Trace.hpp
+     */
+    Trace_Options get_trace_options() const
+    {
+        return trace_options;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the algorithms option
+     * @return vector<string> The names of the algorithms performed by the single, race and batch modes
+     */
+    vector<string> get_algorithms() const
+    {
+        return algorithms;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the parameters of the algorithms
+     * (lbfgs_memory, bfgs_reset, cg_formula, refactor_interval, nonmonotone_memory and learning_rate)
+     * @return Algorithm_Options The parameters of the algorithms, see Algorithm_Options.hpp
+     */
+    Algorithm_Options get_algorithm_options() const
+    {
+        return algorithm_options;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the mode option
+     * @return string "single", "multi_start", "race" or "batch"
+     */
+    string get_mode() const
+    {
+        return mode;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the batch_file option
+     * @return string The name of the batch file of the batch mode
+     */
+    string get_batch_file() const
+    {
+        return batch_file;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the threads option
+     * @return size_t The number of worker threads of the multi-start and batch modes, 0 uses the number of hardware threads
+     */
+    size_t get_num_of_threads() const
+    {
+        return num_of_threads;
+    }
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the options of the multi-start mode
+     * (starts_file, sampling, num_starts, box_lower, box_upper, seed, screen_starts and multi_start_algorithm)
+     * @return Multi_Start_Options The options of the multi-start mode, see Multi_Start.hpp
+     */
+    Multi_Start_Options get_multi_start_options() const
+    {
+        return multi_start_options;
+    }
+
+private:
+    // ======================================================================
+    // Private data of Run_Options
+    // ======================================================================
+
+    string precision{"long_double"}; // default to long double
+    Trace_Options trace_options;     // default to store every iteration in binary format, waiting for the writer
+    string mode{"single"};           // default to run once from initial_point
+    vector<string> algorithms{"gradient_descent", "newtons_method"}; // default algorithms of the single, race and batch modes
+    Algorithm_Options algorithm_options; // default parameters of the algorithms
+    string batch_file{"input_batch.txt"}; // default batch file of the batch mode
+    size_t num_of_threads{0};        // default to the number of hardware threads
+    Multi_Start_Options multi_start_options; // default to 16 Sobol points in [-10, 10], both algorithms
+
+    // ======================================================================
+    // Private member functions of Run_Options: validate values
+    // ======================================================================
+
+    /**
+     * @brief Private member function used to convert an option value to a positive integer
+     * @param value_str The value of the option
+     * @return size_t The positive integer
+     * @throws err_invalid_option if the value is not a positive integer
+     */
+    static size_t positive_integer(const string &value_str)
+    {
+        if (value_str.empty() or value_str.find_first_not_of("0123456789") != string::npos)
+            throw err_invalid_option();
+        size_t value_pi{0};
+        try
+        {
+            value_pi = stoull(value_str);
+        }
+        catch (const out_of_range &e)
+        {
+            throw err_invalid_option();
+        }
+        if (value_pi == 0)
+            throw err_invalid_option();
+        return value_pi;
+    }
+    /**
+     * @brief Private member function used to convert an option value to a finite real number
+     * @param value_str The value of the option
+     * @return long double The real number
+     * @throws err_invalid_option if the value is not a finite real number
+     */
+    static long double real_number(const string &value_str)
+    {
+        size_t num_of_chars{0};
+        long double value_rn{0};
+        try
+        {
+            value_rn = stold(value_str, &num_of_chars);
+        }
+        catch (const exception &e)
+        {
+            throw err_invalid_option();
+        }
+        if (num_of_chars != value_str.size() or !isfinite(value_rn))
+            throw err_invalid_option();
+        return value_rn;
+    }
+
+    /**
+     * @brief Private member function used to convert an option value to a list of algorithm names
+     * @param value_str The value of the option, algorithm names separated by ',', or "all"
+     * @return vector<string> The algorithm names
+     * @throws err_invalid_option if a name is not the name of an algorithm or is repeated
+     */
+    static vector<string> algorithm_list(const string &value_str)
+    {
+        if (value_str == "all")
+            return algorithm_names;
+        vector<string> algorithms_al;
+        size_t name_start{0};
+        while (name_start <= value_str.size())
+        {
+            size_t name_end{value_str.find(',', name_start)};
+            if (name_end == string::npos)
+                name_end = value_str.size();
+            string name_str{value_str.substr(name_start, name_end - name_start)};
+            // each algorithm writes its own output files, thus it can only be performed once
+            if (!is_algorithm_name(name_str) or
+                find(algorithms_al.begin(), algorithms_al.end(), name_str) != algorithms_al.end())
+                throw err_invalid_option();
+            algorithms_al.push_back(name_str);
+            name_start = name_end + 1;
+        }
+        return algorithms_al;
+    }
+};
@@ -0,0 +1,115 @@
+/**
+ * @file Solver_Workspace.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A Solver_Workspace struct that owns the buffers used by the optimization algorithms
+ *
+ * @details This library contains a struct Solver_Workspace used by the optimization algorithms
+ * of Input_Data. Every vector and matrix used inside the iterations (and the AD_Tape of the polynomial)
+ * is allocated once, with the number of x variables of the polynomial, and then overwritten in place
+ * by every iteration, so the iterations do not allocate any memory. The n x n matrices are only allocated
+ * by the algorithms that need them (see allocate_matrices). <br>
+ * A workspace can be reused by any number of runs on the same polynomial, thus each thread
+ * running the algorithms (see Multi_Start.hpp) owns one workspace
+ */
+
+#pragma once
+#include <atomic>
+#include <vector>
+#include "matrix.hpp"
+#include "Polynomial.hpp"
+#include "AD_Tape.hpp"
+
+using namespace std;
+
+/**
+ * @brief A struct for the buffers of the optimization algorithms
+ * @tparam T The scalar type of the buffers
+ */
+template <typename T>
+struct Solver_Workspace
+{
+    /**
+     * @brief Construct a new Solver_Workspace object with all vectors sized for the given polynomial
+     * @param poly The polynomial optimized by the algorithms, its tape is recorded
+     * and the buffers are sized with its number of x variables
+     */
+    Solver_Workspace(const Polynomial<T> &poly)
+        : tape(poly), gradient(poly.get_num_of_x_vars()), direction(poly.get_num_of_x_vars()),
+          trial_x(poly.get_num_of_x_vars()), trial_gradient(poly.get_num_of_x_vars()), hessian(1, 1),
+          hessian_factor(1, 1), inverse_hessian(1, 1), gradient_change(poly.get_num_of_x_vars()),
+          inverse_hessian_product(poly.get_num_of_x_vars()), cg_residual(poly.get_num_of_x_vars()),
+          cg_direction(poly.get_num_of_x_vars()), hessian_vector(poly.get_num_of_x_vars()),
+          previous_x(poly.get_num_of_x_vars()), first_moment(poly.get_num_of_x_vars()),
+          second_moment(poly.get_num_of_x_vars())
+    {
+        hessian_pivots.reserve(poly.get_num_of_x_vars());
+    }
+
+    /**
+     * @brief Member function used to size the n x n matrices (hessian, hessian_factor and inverse_hessian),
+     * only the algorithms that need them call it, so that the other algorithms use O(n) memory
+     */
+    void allocate_matrices()
+    {
+        size_t num_of_x_vars{gradient.size()};
+        if (hessian.get_rows() == num_of_x_vars and hessian_factor.get_rows() == num_of_x_vars)
+            return; // already allocated, also when n is 1
+        hessian = matrix<T>(num_of_x_vars, num_of_x_vars);
+        hessian_factor = matrix<T>(num_of_x_vars, num_of_x_vars);
+        inverse_hessian = matrix<T>(num_of_x_vars, num_of_x_vars);
+    }
+
+    /**
+     * @brief Member function used by the inner loops of the algorithms (the line searches, the trust region
+     * subproblem) to check whether another thread requested the algorithm to stop, see stop_flag
+     * @return true if the stop flag is set
+     */
+    bool stop_requested() const
+    {
+        // only the flag itself is shared, thus no ordering with other memory is needed
+        return stop_flag != nullptr and stop_flag->load(memory_order_relaxed);
+    }
+
+    // the stop flag of a Stop_Observer (see Observer.hpp), set by Algorithm_Race, nullptr if the runs are not stopped
+    const atomic<bool> *stop_flag{nullptr};
+
+    AD_Tape<T> tape;               // tape of the polynomial, evaluates f and the gradient together
+    vector<T> gradient;            // gradient of the current x
+    vector<T> direction;           // search direction of the current iteration
+    vector<T> trial_x;             // trial x of the line search, x + step_size * direction
+    vector<T> trial_gradient;      // gradient of the trial x, used by the wolfe line search
+    matrix<T> hessian;             // hessian of the current x, see allocate_matrices
+    matrix<T> hessian_factor;      // factorization of the hessian, see symmetric_factor in matrix.hpp
+    vector<size_t> hessian_pivots; // row swaps of the factorization
+    vector<T> hessian_scratch;     // per-factor values used by Polynomial::hessian_f, grows to the largest term
+    size_t num_of_factorizations{0};         // hessian factorizations of the last shamanskii run
+    size_t num_of_skipped_factorizations{0}; // iterations of the last shamanskii run that reused a factorization
+
+    // bfgs only uses the upper triangle of the inverse hessian, see symmetric_rank_two_update in matrix.hpp
+    matrix<T> inverse_hessian;         // approximation of the inverse hessian of the current x
+    vector<T> gradient_change;         // y = gradient_next - gradient of the last step
+    vector<T> inverse_hessian_product; // inverse_hessian * y
+
+    // the steihaug conjugate gradient solve of trust_region only uses hessian-vector products
+    vector<T> cg_residual;    // residual of the inner conjugate gradient iterations
+    vector<T> cg_direction;   // direction of the inner conjugate gradient iterations
+    vector<T> hessian_vector; // hessian * vector, see Polynomial::hessian_vector_f
+
+    // the history of lbfgs is sized by its memory, thus it is allocated by the first lbfgs run
+    vector<vector<T>> history_s; // ring buffer of the last steps s = x_next - x
+    vector<vector<T>> history_y; // ring buffer of the last gradient changes y = gradient_next - gradient
+    vector<T> history_rho;       // 1 / (y * s) of each stored pair
+    vector<T> history_alpha;     // coefficients of the first loop of the two-loop recursion
+
+    // the last values of -max_or_min * f of barzilai_borwein, sized by its nonmonotone_memory
+    vector<T> recent_phi;
+
+    // the momentum methods keep O(n) state between iterations instead of running a line search
+    vector<T> previous_x;    // x of the last gradient step of nesterov
+    vector<T> first_moment;  // moving average of the gradient of adam
+    vector<T> second_moment; // moving average of the squared gradient of adam
+};
@@ -0,0 +1,224 @@
+/**
+ * @file Start_Sampling.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief Functions used to generate the initial points of a multi-start optimization
+ *
+ * @details This library contains functions used by Multi_Start to obtain its initial points:
+ * read them from a text file, or sample them in the box [lower, upper]^n with a
+ * Latin hypercube design or a Sobol sequence. <br>
+ * The Sobol sequence uses the direction numbers of Joe and Kuo (new-joe-kuo-6.21201)
+ * for the first 21 dimensions, thus it supports polynomials with up to 21 x variables
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Error_Handling.hpp"
+
+using namespace std;
+
+// ======================================================================
+// Sobol direction numbers
+// ======================================================================
+
+// number of dimensions supported by the Sobol sequence
+constexpr size_t sobol_max_dims{21};
+
+/**
+ * @brief A struct for the primitive polynomial and the initial direction numbers of a Sobol dimension
+ */
+struct Sobol_Direction
+{
+    unsigned int degree;         // degree s of the primitive polynomial
+    unsigned int coefficients;   // coefficients a of the primitive polynomial (without the leading and last 1)
+    unsigned int initial[7];     // initial direction numbers m_1, ..., m_s
+};
+
+// dimensions 2 to 21 of new-joe-kuo-6.21201 (dimension 1 is the van der Corput sequence)
+constexpr Sobol_Direction sobol_directions[sobol_max_dims - 1]{
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+    {7, 4, {1, 3, 7, 13, 13, 15, 69}}};
+
+// ======================================================================
+// Functions used to generate initial points
+// ======================================================================
+
+/**
+ * @brief Function used to read initial points from a text file, one point per line
+ * with its x values separated by ',' (the same format as the initial_point of input_function.txt),
+ * empty lines are ignored
+ * @tparam T The scalar type of the points
+ * @param filename_rs The name of the text file
+ * @param num_of_x_vars_rs The number of x variables of each point
+ * @return vector<vector<T>> The initial points
+ * @throws err_invalid_starts_file if the file cannot be opened, has no point or has an invalid point
+ */
+template <typename T>
+vector<vector<T>> read_starts_file(const string &filename_rs, const size_t &num_of_x_vars_rs)
+{
+    ifstream starts_file{filename_rs};
+    if (!starts_file)
+        throw err_invalid_starts_file();
+    vector<vector<T>> starts_rs;
+    string line_rs;
+    while (getline(starts_file, line_rs))
+    {
+        line_rs.erase(remove_if(line_rs.begin(), line_rs.end(), ::isspace), line_rs.end());
+        if (line_rs.empty())
+            continue;
+        vector<T> start_rs;
+        stringstream line_stream(line_rs);
+        string x_value_str;
+        while (getline(line_stream, x_value_str, ','))
+        {
+            size_t num_of_chars{0};
+            try
+            {
+                start_rs.push_back(static_cast<T>(stold(x_value_str, &num_of_chars)));
+            }
+            catch (const exception &e)
+            {
+                throw err_invalid_starts_file();
+            }
+            if (num_of_chars != x_value_str.size())
+                throw err_invalid_starts_file();
+        }
+        if (start_rs.size() != num_of_x_vars_rs)
+            throw err_invalid_starts_file();
+        starts_rs.push_back(start_rs);
+    }
+    if (starts_rs.empty())
+        throw err_invalid_starts_file();
+    return starts_rs;
+}
+
+/**
+ * @brief Function used to sample initial points in a box with a Latin hypercube design:
+ * each axis is divided into num_of_starts equal intervals and each interval contains exactly
+ * one point, at a random position inside the interval
+ * @tparam T The scalar type of the points
+ * @param num_of_starts_lh The number of points
+ * @param num_of_x_vars_lh The number of x variables of each point
+ * @param lower_lh The lower bound of every x variable
+ * @param upper_lh The upper bound of every x variable
+ * @param seed_lh The seed of the random number generator, the same seed gives the same points
+ * @return vector<vector<T>> The initial points
+ */
+template <typename T>
+vector<vector<T>> latin_hypercube_starts(const size_t &num_of_starts_lh, const size_t &num_of_x_vars_lh,
+                                         const T &lower_lh, const T &upper_lh, const uint64_t &seed_lh)
+{
+    vector<vector<T>> starts_lh(num_of_starts_lh, vector<T>(num_of_x_vars_lh));
+    mt19937_64 generator_lh{seed_lh};
+    uniform_real_distribution<long double> offset_dist{0.0L, 1.0L};
+    vector<size_t> intervals_lh(num_of_starts_lh);
+    for (size_t x_idx{0}; x_idx < num_of_x_vars_lh; x_idx++)
+    {
+        // a random permutation assigns one interval of this axis to each point
+        for (size_t start_idx{0}; start_idx < num_of_starts_lh; start_idx++)
+            intervals_lh[start_idx] = start_idx;
+        shuffle(intervals_lh.begin(), intervals_lh.end(), generator_lh);
+        for (size_t start_idx{0}; start_idx < num_of_starts_lh; start_idx++)
+        {
+            long double unit_lh{(intervals_lh[start_idx] + offset_dist(generator_lh)) / num_of_starts_lh};
+            starts_lh[start_idx][x_idx] = lower_lh + static_cast<T>(unit_lh) * (upper_lh - lower_lh);
+        }
+    }
+    return starts_lh;
+}
+
+/**
+ * @brief Function used to sample initial points in a box with a Sobol sequence,
+ * the first point of the sequence (a corner of the box) is skipped
+ * @tparam T The scalar type of the points
+ * @param num_of_starts_so The number of points
+ * @param num_of_x_vars_so The number of x variables of each point
+ * @param lower_so The lower bound of every x variable
+ * @param upper_so The upper bound of every x variable
+ * @return vector<vector<T>> The initial points
+ * @throws err_sobol_too_many_dims if there are more than sobol_max_dims x variables
+ */
+template <typename T>
+vector<vector<T>> sobol_starts(const size_t &num_of_starts_so, const size_t &num_of_x_vars_so,
+                               const T &lower_so, const T &upper_so)
+{
+    if (num_of_x_vars_so > sobol_max_dims)
+        throw err_sobol_too_many_dims();
+
+    // direction numbers v_k = m_k / 2^k stored as 32-bit integers
+    constexpr unsigned int num_of_bits{32};
+    vector<vector<uint32_t>> directions_so(num_of_x_vars_so, vector<uint32_t>(num_of_bits));
+    for (size_t x_idx{0}; x_idx < num_of_x_vars_so; x_idx++)
+    {
+        vector<uint32_t> &v{directions_so[x_idx]};
+        if (x_idx == 0)
+        {
+            for (unsigned int k{0}; k < num_of_bits; k++)
+                v[k] = uint32_t{1} << (num_of_bits - 1 - k);
+            continue;
+        }
+        const Sobol_Direction &direction_so{sobol_directions[x_idx - 1]};
+        unsigned int s{direction_so.degree};
+        for (unsigned int k{0}; k < num_of_bits; k++)
+        {
+            if (k < s)
+            {
+                v[k] = direction_so.initial[k] << (num_of_bits - 1 - k);
+                continue;
+            }
+            // recurrence of the primitive polynomial
+            v[k] = v[k - s] ^ (v[k - s] >> s);
+            for (unsigned int j{1}; j < s; j++)
+                if ((direction_so.coefficients >> (s - 1 - j)) & 1)
+                    v[k] ^= v[k - j];
+        }
+    }
+
+    // Gray code order: point i differs from point i-1 by the direction of the lowest zero bit of i-1
+    vector<vector<T>> starts_so(num_of_starts_so, vector<T>(num_of_x_vars_so));
+    vector<uint32_t> point_bits(num_of_x_vars_so, 0);
+    for (size_t start_idx{0}; start_idx < num_of_starts_so; start_idx++)
+    {
+        size_t index_so{start_idx};
+        unsigned int lowest_zero_bit{0};
+        while (index_so & 1)
+        {
+            index_so >>= 1;
+            lowest_zero_bit++;
+        }
+        for (size_t x_idx{0}; x_idx < num_of_x_vars_so; x_idx++)
+        {
+            point_bits[x_idx] ^= directions_so[x_idx][lowest_zero_bit];
+            long double unit_so{point_bits[x_idx] / 4294967296.0L}; // divide by 2^32
+            starts_so[start_idx][x_idx] = lower_so + static_cast<T>(unit_so) * (upper_so - lower_so);
+        }
+    }
+    return starts_so;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file Thread_Pool.hpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A fixed-size work-stealing Thread_Pool class
+ *
+ * @details This library contains a class Thread_Pool used to run many independent optimization runs
+ * (see Multi_Start.hpp) on a fixed number of threads. <br>
+ * Each worker thread has its own queue of tasks: tasks are submitted to the queues in turn,
+ * a worker takes the newest task of its own queue, and when its queue is empty it steals
+ * the oldest task of another queue, so the workers stay busy even if the tasks take very different times. <br>
+ * A task is called with the index of the worker running it, in [0, get_num_of_threads()),
+ * so it can use per-worker state (for example a Solver_Workspace) without any locking. <br>
+ * The queues are guarded by one mutex, which is only held to submit or take a task,
+ * the tasks are whole optimization runs, thus the lock is not contended
+ */
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief A class for a work-stealing thread pool
+ */
+class Thread_Pool
+{
+public:
+    // ============
+    // Constructors
+    // ============
+
+    /**
+     * @brief Construct a new Thread_Pool object and start its worker threads
+     * @param input_num_of_threads The number of worker threads, 0 uses the number of hardware threads
+     */
+    Thread_Pool(const size_t &input_num_of_threads)
+    {
+        size_t num_of_threads{input_num_of_threads};
+        if (num_of_threads == 0)
+            num_of_threads = thread::hardware_concurrency();
+        if (num_of_threads == 0)
+            num_of_threads = 1;
+        queues.resize(num_of_threads);
+        for (size_t worker_idx{0}; worker_idx < num_of_threads; worker_idx++)
+            workers.emplace_back(&Thread_Pool::run_worker, this, worker_idx);
+    }
+
+    /**
+     * @brief Destroy the Thread_Pool object, the submitted tasks are finished before the workers stop
+     */
+    ~Thread_Pool()
+    {
+        {
+            unique_lock<mutex> state_lock{state_mutex};
+            all_done.wait(state_lock, [this] { return pending_tasks == 0; });
+            stopping = true;
+        }
+        work_available.notify_all();
+        for (thread &worker : workers)
+            worker.join();
+    }
+
+    Thread_Pool(const Thread_Pool &) = delete;
+    Thread_Pool &operator=(const Thread_Pool &) = delete;
+
+    // ======================================================================
+    // Public member functions of Thread_Pool: run tasks
+    // ======================================================================
+
+    /**
+     * @brief Public member function used to obtain (but not modify) the number of worker threads
+     * @return size_t The number of worker threads
+     */
+    size_t get_num_of_threads() const
+    {
+        return workers.size();
+    }
+
+    /**
+     * @brief Public member function used to submit a task
+     * @param task A function called with the index of the worker running it
+     */
+    void submit(function<void(size_t)> task)
+    {
+        {
+            lock_guard<mutex> state_lock{state_mutex};
+            queues[next_queue].push_back(move(task));
+            next_queue = (next_queue + 1) % queues.size();
+            queued_tasks++;
+            pending_tasks++;
+        }
+        work_available.notify_one();
+    }
+
+    /**
+     * @brief Public member function used to wait until every submitted task is finished
+     * @throws The first exception thrown by a task, if any
+     */
+    void wait()
+    {
+        unique_lock<mutex> state_lock{state_mutex};
+        all_done.wait(state_lock, [this] { return pending_tasks == 0; });
+        if (first_exception)
+        {
+            exception_ptr task_exception{first_exception};
+            first_exception = nullptr;
+            rethrow_exception(task_exception);
+        }
+    }
+
+private:
+    // ======================================================================
+    // Private data of Thread_Pool
+    // ======================================================================
+
+    vector<thread> workers; // worker threads
+
+    mutex state_mutex;                            // guards the data below
+    vector<deque<function<void(size_t)>>> queues; // one queue per worker, the owner takes tasks from the back
+    condition_variable work_available;            // notified when a task is submitted or the pool stops
+    condition_variable all_done;                  // notified when the last pending task finishes
+    size_t queued_tasks{0};                       // tasks submitted but not taken by a worker yet
+    size_t pending_tasks{0};                      // tasks submitted but not finished yet
+    size_t next_queue{0};                         // queue of the next submitted task
+    bool stopping{false};                         // set by the destructor
+    exception_ptr first_exception{nullptr};       // first exception thrown by a task
+
+    // ======================================================================
+    // Private member functions of Thread_Pool: worker threads
+    // ======================================================================
+
+    /**
+     * @brief Private member function used to take a task, first from the back of the own queue,
+     * then (stealing) from the front of the other queues, state_mutex must be held
+     * @param worker_idx The index of the worker
+     * @param task Overwritten with the task taken
+     */
+    void take_task(const size_t &worker_idx, function<void(size_t)> &task)
+    {
+        size_t num_of_queues{queues.size()};
+        for (size_t offset{0}; offset < num_of_queues; offset++)
+        {
+            deque<function<void(size_t)>> &queue{queues[(worker_idx + offset) % num_of_queues]};
+            if (queue.empty())
+                continue;
+            if (offset == 0)
+            {
+                task = move(queue.back());
+                queue.pop_back();
+            }
+            else
+            {
+                task = move(queue.front());
+                queue.pop_front();
+            }
+            queued_tasks--;
+            return;
+        }
+    }
+
+    /**
+     * @brief Private member function run by each worker thread
+     * @param worker_idx The index of the worker
+     */
+    void run_worker(const size_t worker_idx)
+    {
+        while (true)
+        {
+            function<void(size_t)> task;
+            {
+                unique_lock<mutex> state_lock{state_mutex};
+                work_available.wait(state_lock, [this] { return stopping or queued_tasks > 0; });
+                if (queued_tasks == 0)
+                    return; // stopping and no task left
+                take_task(worker_idx, task);
+            }
+            try
+            {
+                task(worker_idx);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> state_lock{state_mutex};
+                if (!first_exception)
+                    first_exception = current_exception();
+            }
+            {
+                lock_guard<mutex> state_lock{state_mutex};
+                pending_tasks--;
+                if (pending_tasks == 0)
+                    all_done.notify_all();
+            }
+        }
+    }
+};
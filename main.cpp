@@ -8,35 +8,166 @@
  * @brief The main file running optimization algorithms based on the data stored in input_function.txt
  */
 
+#include <future>
 #include <iostream>
+#include <string>
+#include <vector>
 #include "Input_Data.hpp"
 #include "Result_Handling.hpp"
+#include "Multi_Start.hpp"
+#include "Algorithm_Race.hpp"
+#include "Batch_Solver.hpp"
+#include "Run_Options.hpp"
 
 using namespace std;
 
-int main()
+/**
+ * @brief Function used to run the optimization algorithms with the given scalar type
+ * @tparam T The scalar type, float, double or long double
+ * @param options The command line options
+ */
+template <typename T>
+void run_algorithms(const Run_Options &options)
+{
+    // (string) constructor: create an Input_Data class based on input_function.txt
+    Input_Data<T> input_f("input_function.txt");
+    input_f.set_trace_options(options.get_trace_options());
+    input_f.set_algorithm_options(options.get_algorithm_options());
+
+    // the algorithms do not modify input_f, thus they run at the same time on separate threads
+    vector<future<void>> results_f;
+    for (const string &algorithm_str : options.get_algorithms())
+        // (Input_Data, string) constructor: create a Result_Handling class by applying the algorithm
+        results_f.push_back(async(launch::async, [&input_f, algorithm_str] {
+            Result_Handling<T> result_f(input_f, algorithm_str);
+        }));
+
+    // get() waits for each algorithm and rethrows its exception, if any
+    for (future<void> &result_f : results_f)
+        result_f.get();
+}
+
+/**
+ * @brief Function used to run the optimization algorithms from many initial points with the given scalar type
+ * @tparam T The scalar type, float, double or long double
+ * @param options The command line options
+ */
+template <typename T>
+void run_multi_start(const Run_Options &options)
+{
+    // (string) constructor: create an Input_Data class based on input_function.txt
+    Input_Data<T> input_f("input_function.txt");
+    input_f.set_algorithm_options(options.get_algorithm_options());
+
+    // (Input_Data, Multi_Start_Options, size_t) constructor: run the algorithms from every initial point
+    Multi_Start<T> multi_start_f(input_f, options.get_multi_start_options(), options.get_num_of_threads());
+    multi_start_f.store_results("output_results_multi_start.txt");
+}
+
+/**
+ * @brief Function used to race the optimization algorithms from the initial point with the given scalar type
+ * @tparam T The scalar type, float, double or long double
+ * @param options The command line options
+ */
+template <typename T>
+void run_race(const Run_Options &options)
+{
+    // (string) constructor: create an Input_Data class based on input_function.txt
+    Input_Data<T> input_f("input_function.txt");
+    input_f.set_algorithm_options(options.get_algorithm_options());
+
+    // (Input_Data, vector<string>) constructor: run every algorithm on its own thread until one of them converges
+    Algorithm_Race<T> race_f(input_f, options.get_algorithms());
+    race_f.store_results("output_results_race.txt");
+}
+
+/**
+ * @brief Function used to solve every problem of a batch file with the given scalar type
+ * @tparam T The scalar type, float, double or long double
+ * @param options The command line options
+ */
+template <typename T>
+void run_batch(const Run_Options &options)
+{
+    // (string, vector<string>, Algorithm_Options, size_t) constructor: read the batch file and solve every problem in parallel
+    Batch_Solver<T> batch_f(options.get_batch_file(), options.get_algorithms(), options.get_algorithm_options(),
+                            options.get_num_of_threads());
+    batch_f.store_results("output_results_batch.txt");
+}
+
+int main(int argc, char *argv[])
 {
     try
     {
-        // (string) constructor: create an Input_Data class based on input_function.txt
-        Input_Data input_f("input_function.txt");
+        // (int, char *[]) constructor: read the key=value options from the command line
+        Run_Options options(argc, argv);
+
+        if (options.get_mode() == "multi_start")
+        {
+            if (options.get_precision() == "float")
+                run_multi_start<float>(options);
+            else if (options.get_precision() == "double")
+                run_multi_start<double>(options);
+            else
+                run_multi_start<long double>(options);
+
+            cout << "Successfully performed the multi-start optimization!" << '\n';
+            cout << "Please check the following file:" << '\n';
+            cout << "    output_results_multi_start.txt" << '\n';
+            return 0;
+        }
+
+        if (options.get_mode() == "race")
+        {
+            if (options.get_precision() == "float")
+                run_race<float>(options);
+            else if (options.get_precision() == "double")
+                run_race<double>(options);
+            else
+                run_race<long double>(options);
 
-        // (Input_Data, string) constructor: create a Result_Handling class by applying the gradient_descent algorithm
-        Result_Handling result_f1(input_f, "gradient_descent");
+            cout << "Successfully performed the algorithm race!" << '\n';
+            cout << "Please check the following file:" << '\n';
+            cout << "    output_results_race.txt" << '\n';
+            return 0;
+        }
 
-        // (Input_Data, string) constructor: create a Result_Handling class by applying the newtons_method algorithm
-        Result_Handling result_f2(input_f, "newtons_method");
+        if (options.get_mode() == "batch")
+        {
+            if (options.get_precision() == "float")
+                run_batch<float>(options);
+            else if (options.get_precision() == "double")
+                run_batch<double>(options);
+            else
+                run_batch<long double>(options);
+
+            cout << "Successfully solved the batch of problems!" << '\n';
+            cout << "Please check the following file:" << '\n';
+            cout << "    output_results_batch.txt" << '\n';
+            return 0;
+        }
+
+        if (options.get_precision() == "float")
+            run_algorithms<float>(options);
+        else if (options.get_precision() == "double")
+            run_algorithms<double>(options);
+        else
+            run_algorithms<long double>(options);
 
         cout << "Successfully performed the optimization algorithms!" << '\n';
         cout << "Please check the following files:" << '\n';
-        cout << "    output_results_gradient_descent.txt" << '\n';
-        cout << "    output_results_newtons_method.txt" << '\n';
-        cout << "    output_iterations_gradient_descent.txt" << '\n';
-        cout << "    output_iterations_newtons_method.txt" << '\n';
+        for (const string &algorithm_str : options.get_algorithms())
+            cout << "    output_results_" << algorithm_str << ".txt" << '\n';
+        if (options.get_trace_options().format != "none")
+        {
+            string trace_extension{options.get_trace_options().format == "binary" ? ".bin" : ".txt"};
+            for (const string &algorithm_str : options.get_algorithms())
+                cout << "    output_iterations_" << algorithm_str << trace_extension << '\n';
+        }
     }
     catch (const exception &e)
     {
         cout << e.what() << '\n';
         return -1;
     }
-}
+}
\ No newline at end of file
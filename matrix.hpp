@@ -10,8 +10,10 @@
  * @details This library contains a class template for matrices. The matrices can be of arbitrary size. Overloaded operators for common matrix operations such as addition and multiplication are defined.
  */
 
+#include <cmath>
 #include <initializer_list>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -97,6 +99,16 @@ public:
     {
     };
 
+    // Exception to be thrown if a matrix that must be square is not square
+    class not_square
+    {
+    };
+
+    // Exception to be thrown if a singular matrix is factored by lu_factor
+    class singular_matrix
+    {
+    };
+
 private:
     // The number of rows
     size_t rows{0};
@@ -144,6 +156,87 @@ matrix<T> operator*(const T &, const matrix<T> &);
 template <typename T>
 matrix<T> operator*(const matrix<T> &, const T &);
 
+// The kind of factorization stored by symmetric_factor, used to select the matching solve
+enum class factorization
+{
+    cholesky,
+    ldlt,
+    lu
+};
+
+// Function used to factor a square matrix in place into P*A = L*U by Gaussian elimination with partial pivoting
+// First argument: the matrix A, overwritten with L below the diagonal (unit diagonal not stored) and U on and above it
+// Second argument: the row swaps, at step k row k was swapped with row pivots[k]
+// Throws singular_matrix if a zero pivot is found
+template <typename T>
+void lu_factor(matrix<T> &, vector<size_t> &);
+
+// Function used to solve A*x = b in place given the factorization from lu_factor
+// First argument: the factored matrix
+// Second argument: the row swaps
+// Third argument: the right-hand side b, overwritten with the solution x
+template <typename T>
+void lu_solve(const matrix<T> &, const vector<size_t> &, vector<T> &);
+
+// Function used to factor a symmetric positive definite matrix in place into A = L*L^T
+// Argument: the matrix A, its lower triangle is overwritten with L (the upper triangle is not used)
+// Returns false if A is not positive definite, in which case A is left partially overwritten
+template <typename T>
+bool cholesky_factor(matrix<T> &);
+
+// Function used to solve A*x = b in place given the factorization from cholesky_factor
+// First argument: the factored matrix
+// Second argument: the right-hand side b, overwritten with the solution x
+template <typename T>
+void cholesky_solve(const matrix<T> &, vector<T> &);
+
+// Function used to factor a symmetric (possibly indefinite) matrix in place into P*A*P^T = L*D*L^T
+// using 1x1 diagonal pivots with symmetric pivoting
+// First argument: the matrix A, overwritten with L off the diagonal (unit diagonal not stored) and D on the diagonal
+// Second argument: the symmetric swaps, at step k row/column k was swapped with row/column pivots[k]
+// Returns false if no stable 1x1 pivot exists (ex: a zero diagonal), in which case A is left partially overwritten
+template <typename T>
+bool ldlt_factor(matrix<T> &, vector<size_t> &);
+
+// Function used to solve A*x = b in place given the factorization from ldlt_factor
+// First argument: the factored matrix
+// Second argument: the symmetric swaps
+// Third argument: the right-hand side b, overwritten with the solution x
+template <typename T>
+void ldlt_solve(const matrix<T> &, const vector<size_t> &, vector<T> &);
+
+// Function used to factor a symmetric matrix with the cheapest factorization that works:
+// Cholesky if it is positive definite, otherwise LDL^T, otherwise LU with partial pivoting
+// First argument: the symmetric matrix A (not modified)
+// Second argument: a matrix of the same size, overwritten with the factorization
+// Third argument: the row swaps of the factorization (not used by Cholesky)
+// Returns the kind of factorization stored, throws singular_matrix if A is singular
+template <typename T>
+factorization symmetric_factor(const matrix<T> &, matrix<T> &, vector<size_t> &);
+
+// Function used to solve A*x = b in place given the factorization from symmetric_factor
+// First argument: the factored matrix
+// Second argument: the row swaps
+// Third argument: the kind of factorization
+// Fourth argument: the right-hand side b, overwritten with the solution x
+template <typename T>
+void factored_solve(const matrix<T> &, const vector<size_t> &, const factorization &, vector<T> &);
+
+// Function used to compute y = A*x for a symmetric matrix A, reading only its upper triangle row by row
+// First argument: the symmetric matrix A, its lower triangle is not used
+// Second argument: the vector x
+// Third argument: a vector of the same size as x, overwritten with y
+template <typename T>
+void symmetric_multiply(const matrix<T> &, const vector<T> &, vector<T> &);
+
+// Function used to apply the symmetric rank-two update A += alpha*(u*v^T + v*u^T) + beta*u*u^T
+// to the upper triangle of A, row by row, so every row is updated in one contiguous pass
+// First argument: the symmetric matrix A, its lower triangle is not used or updated
+// Second and third arguments: the vectors u and v
+// Fourth and fifth arguments: the scalars alpha and beta
+template <typename T>
+void symmetric_rank_two_update(matrix<T> &, const vector<T> &, const vector<T> &, const T &, const T &);
+
 // ==============
 // Implementation
 // ==============
@@ -318,4 +411,240 @@ template <typename T>
 matrix<T> operator*(const matrix<T> &m, const T &s)
 {
     return s * m;
-}
\ No newline at end of file
+}
+
+template <typename T>
+void lu_factor(matrix<T> &a, vector<size_t> &pivots)
+{
+    size_t n{a.get_rows()};
+    if (n != a.get_cols())
+        throw typename matrix<T>::not_square{};
+    pivots.resize(n);
+    for (size_t k{0}; k < n; k++)
+    {
+        // choose the row with the largest entry in column k as the pivot row
+        size_t p{k};
+        for (size_t i{k + 1}; i < n; i++)
+            if (abs(a(i, k)) > abs(a(p, k)))
+                p = i;
+        if (a(p, k) == T{0})
+            throw typename matrix<T>::singular_matrix{};
+        pivots[k] = p;
+        if (p != k)
+            for (size_t j{0}; j < n; j++)
+                swap(a(k, j), a(p, j));
+        // eliminate the entries below the pivot, storing the multipliers in L
+        for (size_t i{k + 1}; i < n; i++)
+        {
+            a(i, k) /= a(k, k);
+            for (size_t j{k + 1}; j < n; j++)
+                a(i, j) -= a(i, k) * a(k, j);
+        }
+    }
+}
+
+template <typename T>
+void lu_solve(const matrix<T> &a, const vector<size_t> &pivots, vector<T> &b)
+{
+    size_t n{a.get_rows()};
+    // b = P*b
+    for (size_t k{0}; k < n; k++)
+        swap(b[k], b[pivots[k]]);
+    // forward substitution L*y = b
+    for (size_t i{1}; i < n; i++)
+        for (size_t j{0}; j < i; j++)
+            b[i] -= a(i, j) * b[j];
+    // backward substitution U*x = y
+    for (size_t i{n}; i-- > 0;)
+    {
+        for (size_t j{i + 1}; j < n; j++)
+            b[i] -= a(i, j) * b[j];
+        b[i] /= a(i, i);
+    }
+}
+
+template <typename T>
+bool cholesky_factor(matrix<T> &a)
+{
+    size_t n{a.get_rows()};
+    if (n != a.get_cols())
+        throw typename matrix<T>::not_square{};
+    for (size_t j{0}; j < n; j++)
+    {
+        T diagonal{a(j, j)};
+        for (size_t k{0}; k < j; k++)
+            diagonal -= a(j, k) * a(j, k);
+        if (!(diagonal > T{0})) // also rejects nan
+            return false;
+        a(j, j) = sqrt(diagonal);
+        for (size_t i{j + 1}; i < n; i++)
+        {
+            T entry{a(i, j)};
+            for (size_t k{0}; k < j; k++)
+                entry -= a(i, k) * a(j, k);
+            a(i, j) = entry / a(j, j);
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void cholesky_solve(const matrix<T> &a, vector<T> &b)
+{
+    size_t n{a.get_rows()};
+    // forward substitution L*y = b
+    for (size_t i{0}; i < n; i++)
+    {
+        for (size_t j{0}; j < i; j++)
+            b[i] -= a(i, j) * b[j];
+        b[i] /= a(i, i);
+    }
+    // backward substitution L^T*x = y
+    for (size_t i{n}; i-- > 0;)
+    {
+        for (size_t j{i + 1}; j < n; j++)
+            b[i] -= a(j, i) * b[j];
+        b[i] /= a(i, i);
+    }
+}
+
+template <typename T>
+bool ldlt_factor(matrix<T> &a, vector<size_t> &pivots)
+{
+    // a 1x1 pivot is accepted only if it is not much smaller than the rest of its column,
+    // this is the Bunch-Kaufman bound alpha = (1 + sqrt(17)) / 8 which limits element growth
+    const T alpha{(T{1} + sqrt(T{17})) / T{8}};
+    size_t n{a.get_rows()};
+    if (n != a.get_cols())
+        throw typename matrix<T>::not_square{};
+    pivots.resize(n);
+    for (size_t k{0}; k < n; k++)
+    {
+        // choose the largest remaining diagonal entry as the pivot
+        size_t p{k};
+        for (size_t i{k + 1}; i < n; i++)
+            if (abs(a(i, i)) > abs(a(p, p)))
+                p = i;
+        pivots[k] = p;
+        if (p != k)
+        {
+            // the whole matrix is kept symmetric, so swap both the rows and the columns
+            for (size_t j{0}; j < n; j++)
+                swap(a(k, j), a(p, j));
+            for (size_t i{0}; i < n; i++)
+                swap(a(i, k), a(i, p));
+        }
+        T d{a(k, k)};
+        T max_off_diagonal{0};
+        for (size_t i{k + 1}; i < n; i++)
+            max_off_diagonal = max(max_off_diagonal, abs(a(i, k)));
+        if (d == T{0} or !(abs(d) >= alpha * max_off_diagonal))
+            return false;
+        // compute column k of L and update the trailing submatrix A -= l*d*l^T
+        for (size_t i{k + 1}; i < n; i++)
+            a(i, k) /= d;
+        for (size_t i{k + 1}; i < n; i++)
+        {
+            for (size_t j{k + 1}; j <= i; j++)
+            {
+                a(i, j) -= a(i, k) * d * a(j, k);
+                a(j, i) = a(i, j);
+            }
+        }
+        for (size_t i{k + 1}; i < n; i++)
+            a(k, i) = a(i, k);
+    }
+    return true;
+}
+
+template <typename T>
+void ldlt_solve(const matrix<T> &a, const vector<size_t> &pivots, vector<T> &b)
+{
+    size_t n{a.get_rows()};
+    // b = P*b
+    for (size_t k{0}; k < n; k++)
+        swap(b[k], b[pivots[k]]);
+    // forward substitution L*y = b
+    for (size_t i{1}; i < n; i++)
+        for (size_t j{0}; j < i; j++)
+            b[i] -= a(i, j) * b[j];
+    // diagonal D*z = y
+    for (size_t i{0}; i < n; i++)
+        b[i] /= a(i, i);
+    // backward substitution L^T*w = z
+    for (size_t i{n}; i-- > 0;)
+        for (size_t j{i + 1}; j < n; j++)
+            b[i] -= a(j, i) * b[j];
+    // x = P^T*w, undo the swaps in reverse order
+    for (size_t k{n}; k-- > 0;)
+        swap(b[k], b[pivots[k]]);
+}
+
+template <typename T>
+factorization symmetric_factor(const matrix<T> &a, matrix<T> &factor, vector<size_t> &pivots)
+{
+    factor = a;
+    if (cholesky_factor(factor))
+        return factorization::cholesky;
+    factor = a;
+    if (ldlt_factor(factor, pivots))
+        return factorization::ldlt;
+    factor = a;
+    lu_factor(factor, pivots);
+    return factorization::lu;
+}
+
+template <typename T>
+void factored_solve(const matrix<T> &factor, const vector<size_t> &pivots,
+                    const factorization &kind, vector<T> &b)
+{
+    if (b.size() != factor.get_rows())
+        throw typename matrix<T>::incompatible_sizes_multiply{};
+    if (kind == factorization::cholesky)
+        cholesky_solve(factor, b);
+    else if (kind == factorization::ldlt)
+        ldlt_solve(factor, pivots, b);
+    else
+        lu_solve(factor, pivots, b);
+}
+
+template <typename T>
+void symmetric_multiply(const matrix<T> &a, const vector<T> &x, vector<T> &y)
+{
+    size_t n{a.get_rows()};
+    if (n != a.get_cols())
+        throw typename matrix<T>::not_square{};
+    if (x.size() != n or y.size() != n)
+        throw typename matrix<T>::incompatible_sizes_multiply{};
+    for (size_t i{0}; i < n; i++)
+        y[i] = T{0};
+    // row i of the upper triangle contributes to y[i] (as a row) and to y[j], j > i (as column i of the lower triangle)
+    for (size_t i{0}; i < n; i++)
+    {
+        T row_sum{a(i, i) * x[i]};
+        for (size_t j{i + 1}; j < n; j++)
+        {
+            row_sum += a(i, j) * x[j];
+            y[j] += a(i, j) * x[i];
+        }
+        y[i] += row_sum;
+    }
+}
+
+template <typename T>
+void symmetric_rank_two_update(matrix<T> &a, const vector<T> &u, const vector<T> &v, const T &alpha, const T &beta)
+{
+    size_t n{a.get_rows()};
+    if (n != a.get_cols())
+        throw typename matrix<T>::not_square{};
+    if (u.size() != n or v.size() != n)
+        throw typename matrix<T>::incompatible_sizes_multiply{};
+    for (size_t i{0}; i < n; i++)
+    {
+        // a(i, j) += u[j] * (alpha * v[i] + beta * u[i]) + v[j] * (alpha * u[i]), for j >= i
+        T u_coeff{alpha * v[i] + beta * u[i]};
+        T v_coeff{alpha * u[i]};
+        for (size_t j{i}; j < n; j++)
+            a(i, j) += u_coeff * u[j] + v_coeff * v[j];
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file compare_batch.cpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A test that compares the batched evaluate functions of Polynomial with the scalar ones
+ *
+ * @details eval_f_batch and gradient_f_batch are evaluated at random points, stored in a Point_Batch whose
+ * number of points is not a multiple of the padding of its rows, and compared with eval_f and gradient_f at
+ * each point. The batched functions compute in double precision, thus the allowed difference depends on the
+ * scalar type of the Polynomial. Usage: "./compare_batch", it returns 0 if the test passes.
+ * Compile with, for example:
+ * "g++ -std=c++17 -O2 -pthread tools/compare_batch.cpp AD_Tape_evaluate.cpp Input_Data_evaluate.cpp
+ * Input_Data_validate.cpp Polynomial_evaluate.cpp Polynomial_validate.cpp -o compare_batch"
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Input_Data.hpp"
+#include "../Point_Batch.hpp"
+
+using namespace std;
+
+/**
+ * @brief Function used to compare the batched and the scalar evaluate functions of a polynomial
+ * @tparam T The scalar type of the polynomial
+ * @param function_str The line "f(x_1, ...)=..." of the polynomial
+ * @param initial_point_str The line "initial_point=..." of the polynomial, only used to validate the input
+ * @param max_difference The largest allowed difference, relative to 1 + the absolute scalar value
+ * @param type_str The name of T, to print the result
+ * @return true if every value of the batch is close to the scalar value
+ */
+template <typename T>
+bool same_values(const string &function_str, const string &initial_point_str, const double &max_difference,
+                 const string &type_str)
+{
+    vector<string> lines_cb{"min", function_str, initial_point_str, "tolerance=0.001", "max_iter=1"};
+    Input_Data<T> input_cb(lines_cb);
+    const Polynomial<T> &polyn_cb{input_cb.get_polynomial()};
+    size_t num_of_x_vars{polyn_cb.get_num_of_x_vars()};
+
+    // 37 points, so the last row of 8 lanes is only partly used
+    const size_t num_of_points{37};
+    mt19937_64 generator_cb{2020};
+    uniform_real_distribution<double> distribution_cb{-2, 2};
+    Point_Batch points_cb(num_of_x_vars, num_of_points);
+    for (size_t point_idx{0}; point_idx < num_of_points; point_idx++)
+    {
+        vector<T> x_vars_cb(num_of_x_vars);
+        for (T &x : x_vars_cb)
+            x = static_cast<T>(distribution_cb(generator_cb));
+        points_cb.set_point(point_idx, x_vars_cb);
+    }
+
+    vector<double> f_batch;
+    Point_Batch gradients_batch(num_of_x_vars, num_of_points);
+    polyn_cb.eval_f_batch(points_cb, f_batch);
+    polyn_cb.gradient_f_batch(points_cb, gradients_batch);
+
+    // the largest difference of f and of the gradient over all points
+    double f_difference{0}, gradient_difference{0};
+    vector<T> gradient_cb(num_of_x_vars);
+    for (size_t point_idx{0}; point_idx < num_of_points; point_idx++)
+    {
+        vector<T> x_vars_cb{points_cb.get_point<T>(point_idx)};
+        double f_scalar{static_cast<double>(polyn_cb.eval_f(x_vars_cb))};
+        f_difference = max(f_difference, abs(f_batch[point_idx] - f_scalar) / (1 + abs(f_scalar)));
+        polyn_cb.gradient_f(x_vars_cb, gradient_cb);
+        for (size_t x_idx{0}; x_idx < num_of_x_vars; x_idx++)
+        {
+            double df_scalar{static_cast<double>(gradient_cb[x_idx])};
+            gradient_difference = max(gradient_difference,
+                                      abs(gradients_batch(x_idx, point_idx) - df_scalar) / (1 + abs(df_scalar)));
+        }
+    }
+
+    // a nan difference fails the test
+    bool passed{f_difference <= max_difference and gradient_difference <= max_difference};
+    cout << (passed ? "PASS " : "FAIL ") << function_str << " (" << type_str << "): largest difference of f "
+         << f_difference << ", of the gradient " << gradient_difference << '\n';
+    return passed;
+}
+
+int main()
+{
+    bool passed{true};
+    try
+    {
+        // pairs of "f(x_1, ...)=..." and a valid "initial_point=..." of the same number of x variables
+        const vector<pair<string, string>> polynomials_cb{
+            {"f(x_1,x_2)=1 - 2*x_1 + x_1^2 + 100*x_1^4 - 200*x_1^2*x_2 + 100*x_2^2", "initial_point=0,0"},
+            {"f(x_1)=3*x_1^7 - x_1^3 + 0.5", "initial_point=0"},
+            {"f(x_1,x_2,x_3)=x_1*x_2*x_3 + 2*x_1^3*x_3^2 - x_2^5 + 4*x_3 - 7", "initial_point=0,0,0"},
+            {"f(x_1,x_2,x_3,x_4)=x_1^2*x_2^2*x_3^2*x_4^2 - x_1*x_4^3 + 0.25*x_2^6 + x_3", "initial_point=1,1,1,1"}};
+
+        for (const pair<string, string> &polynomial_cb : polynomials_cb)
+        {
+            passed = same_values<float>(polynomial_cb.first, polynomial_cb.second, 1e-4, "float") and passed;
+            passed = same_values<double>(polynomial_cb.first, polynomial_cb.second, 1e-12, "double") and passed;
+            passed = same_values<long double>(polynomial_cb.first, polynomial_cb.second, 1e-12, "long double") and passed;
+        }
+    }
+    catch (const exception &e)
+    {
+        cout << e.what() << '\n';
+        return -1;
+    }
+    return passed ? 0 : 1;
+}
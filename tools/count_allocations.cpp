@@ -0,0 +1,153 @@
+/**
+ * @file count_allocations.cpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A test that counts the heap allocations of the optimization algorithms
+ *
+ * @details The global operator new is replaced by one that counts its calls. Each algorithm of algorithm_names
+ * is run with max_iter=3 and max_iter=40 on a problem that no algorithm solves within 40 iterations, with a
+ * Solver_Workspace created (and sized by a first run) before counting. Each algorithm is run once with a
+ * Null_Observer and once with an Iteration_Trace storing a binary trace, created before counting, so that the
+ * iterations of the trace (the ring buffer and the writer thread) are counted as well. The iterations must not
+ * allocate, thus both runs must make the same number of allocations. Usage: "./count_allocations", it returns 0
+ * if the test passes, the traces are removed afterwards. Compile with, for example:
+ * "g++ -std=c++17 -O2 -pthread tools/count_allocations.cpp AD_Tape_evaluate.cpp Input_Data_evaluate.cpp
+ * Input_Data_validate.cpp Polynomial_evaluate.cpp Polynomial_validate.cpp -o count_allocations"
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "../Algorithm_Options.hpp"
+#include "../Input_Data.hpp"
+#include "../Iteration_Trace.hpp"
+#include "../Observer.hpp"
+#include "../Solver_Workspace.hpp"
+
+using namespace std;
+
+// number of calls of operator new since the program started
+atomic<size_t> num_of_allocations{0};
+
+void *operator new(size_t size)
+{
+    num_of_allocations.fetch_add(1, memory_order_relaxed);
+    if (void *ptr{malloc(size == 0 ? 1 : size)})
+        return ptr;
+    throw bad_alloc();
+}
+
+// not inlined, so that the compiler does not pair free with the operator new of the caller
+[[gnu::noinline]] void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+/**
+ * @brief Function used to count the allocations of one run of an algorithm
+ * @tparam T The scalar type of the problem
+ * @param algorithm_str The name of the algorithm
+ * @param max_iter_str The max_iter of the problem, the number of iterations of the run
+ * @param traced If true, the iterations are stored to a binary trace by an Iteration_Trace
+ * @param case_ca Overwritten with the case returned by the algorithm
+ * @return size_t The number of allocations of the run
+ */
+template <typename T>
+size_t count_allocations(const string &algorithm_str, const string &max_iter_str, const bool &traced, int &case_ca)
+{
+    // f has a single stationary point at 0, which every algorithm only approaches linearly since the hessian
+    // is 0 there, the tolerance is never met, thus the algorithm runs exactly max_iter iterations
+    vector<string> lines_ca{"min", "f(x_1,x_2)=x_1^4 + 2*x_2^4 + x_1^2*x_2^2", "initial_point=1,2", "tolerance=1e-30",
+                            "max_iter=" + max_iter_str};
+    Input_Data<T> input_ca(lines_ca);
+    Solver_Workspace<T> workspace_ca(input_ca.get_polynomial());
+    Null_Observer observer_ca;
+    vector<T> x_start_ca{input_ca.get_x_initial()};
+    vector<T> x_current_ca(x_start_ca.size());
+
+    // a first run sizes the workspace, for example the matrices of newtons_method
+    input_ca.run_algorithm(algorithm_str, x_start_ca, x_current_ca, workspace_ca, observer_ca);
+    if (!traced)
+    {
+        size_t allocations_before{num_of_allocations.load()};
+        case_ca = input_ca.run_algorithm(algorithm_str, x_start_ca, x_current_ca, workspace_ca, observer_ca);
+        return num_of_allocations.load() - allocations_before;
+    }
+
+    // the trace opens its file and starts its writer thread before counting,
+    // finish waits for the writer thread, so that all of its allocations are counted
+    Trace_Options trace_options_ca;
+    trace_options_ca.format = "binary";
+    Iteration_Trace<T> trace_ca(algorithm_str, trace_options_ca, x_start_ca.size(), input_ca.get_min_max());
+    size_t allocations_before{num_of_allocations.load()};
+    case_ca = input_ca.run_algorithm(algorithm_str, x_start_ca, x_current_ca, workspace_ca, trace_ca);
+    trace_ca.finish();
+    size_t allocations_ca{num_of_allocations.load() - allocations_before};
+    remove(("output_iterations_" + algorithm_str + ".bin").c_str());
+    return allocations_ca;
+}
+
+/**
+ * @brief Function used to compare the allocations of an algorithm for 3 and 40 iterations
+ * @tparam T The scalar type of the problem
+ * @param algorithm_str The name of the algorithm
+ * @param traced If true, the iterations are stored to a binary trace by an Iteration_Trace
+ * @param type_str The name of T, to print the result
+ * @return true if both runs reached max_iter and made the same number of allocations
+ */
+template <typename T>
+bool same_allocations(const string &algorithm_str, const bool &traced, const string &type_str)
+{
+    int case_3{0}, case_40{0};
+    size_t allocations_3{count_allocations<T>(algorithm_str, "3", traced, case_3)};
+    size_t allocations_40{count_allocations<T>(algorithm_str, "40", traced, case_40)};
+    bool passed{case_3 == 2 and case_40 == 2 and allocations_3 == allocations_40};
+    cout << (passed ? "PASS " : "FAIL ") << algorithm_str << (traced ? " with a binary trace" : "")
+         << " (" << type_str << "): "
+         << allocations_3 << " allocations for 3 iterations (case " << case_3 << "), "
+         << allocations_40 << " allocations for 40 iterations (case " << case_40 << ")" << '\n';
+    return passed;
+}
+
+int main()
+{
+    bool passed{true};
+    try
+    {
+        // the counter must see the allocations of the constructor of Input_Data, otherwise operator new is not replaced
+        size_t allocations_before{num_of_allocations.load()};
+        Input_Data<double> input_check(vector<string>{"min", "f(x_1)=x_1^2", "initial_point=1", "tolerance=0.1",
+                                                      "max_iter=1"});
+        if (num_of_allocations.load() == allocations_before)
+        {
+            cout << "FAIL the allocations are not counted" << '\n';
+            return 1;
+        }
+
+        for (const string &algorithm_str : algorithm_names)
+            for (const bool traced : {false, true})
+            {
+                passed = same_allocations<float>(algorithm_str, traced, "float") and passed;
+                passed = same_allocations<double>(algorithm_str, traced, "double") and passed;
+                passed = same_allocations<long double>(algorithm_str, traced, "long double") and passed;
+            }
+    }
+    catch (const exception &e)
+    {
+        cout << e.what() << '\n';
+        return -1;
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file trace_to_text.cpp
+ * @author Jun Yi (Jason) Shi (shij82@mcmaster.ca)
+ * @version 0.1
+ * @date 2020-12-13
+ * @copyright Copyright (c) 2020
+ *
+ * @brief A tool that converts a binary iteration trace to the text layout of the output_iterations files
+ *
+ * @details Usage: "./trace_to_text output_iterations_gradient_descent.bin [output.txt]".
+ * If the output file is not given, the .bin extension of the trace is replaced by .txt.
+ * The binary format is described in Iteration_Trace.hpp. Compile with, for example:
+ * "g++ -std=c++17 -O2 tools/trace_to_text.cpp -o trace_to_text"
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../Iteration_Trace.hpp"
+#include "../vector_overloads.hpp"
+#include "../Error_Handling.hpp"
+
+using namespace std;
+
+/**
+ * @brief Function used to read a value of type V from a binary file
+ * @param trace_file The binary file
+ * @return V The value read
+ * @throws err_invalid_trace_file if the file ends before the value
+ */
+template <typename V>
+V read_value(ifstream &trace_file)
+{
+    V value{};
+    if (!trace_file.read(reinterpret_cast<char *>(&value), sizeof(V)))
+        throw err_invalid_trace_file();
+    return value;
+}
+
+/**
+ * @brief Function used to convert a binary trace to the text layout
+ * @param trace_filename The name of the binary trace
+ * @param text_filename The name of the text file to create
+ * @throws err_invalid_trace_file if the trace cannot be opened or is not a valid trace
+ * @throws err_fail_to_read_iter_txt if the text file cannot be opened
+ */
+void trace_to_text(const string &trace_filename, const string &text_filename)
+{
+    ifstream trace_file{trace_filename, ios::binary};
+    if (!trace_file)
+        throw err_invalid_trace_file();
+
+    // header
+    char magic_field[sizeof(trace_magic)];
+    if (!trace_file.read(magic_field, sizeof(magic_field)) or memcmp(magic_field, trace_magic, sizeof(trace_magic)) != 0)
+        throw err_invalid_trace_file();
+    if (read_value<uint64_t>(trace_file) != trace_version)
+        throw err_invalid_trace_file();
+    char algorithm_field[trace_algorithm_size];
+    if (!trace_file.read(algorithm_field, trace_algorithm_size))
+        throw err_invalid_trace_file();
+    algorithm_field[trace_algorithm_size - 1] = '\0';
+    string algorithm_str{algorithm_field};
+    size_t num_of_x_vars{read_value<uint64_t>(trace_file)};
+    read_value<uint64_t>(trace_file); // stride, not needed since each record stores its iteration
+    if (num_of_x_vars == 0)
+        throw err_invalid_trace_file();
+
+    ofstream store_iters{text_filename};
+    if (!store_iters)
+        throw err_fail_to_read_iter_txt();
+    store_iters.precision(10);
+
+    // records
+    vector<double> record(trace_record_size(num_of_x_vars));
+    vector<double> x(num_of_x_vars), gradient(num_of_x_vars), next_x(num_of_x_vars);
+    size_t record_bytes{record.size() * sizeof(double)};
+    while (trace_file.read(reinterpret_cast<char *>(record.data()), record_bytes))
+    {
+        unsigned int flags{static_cast<unsigned int>(record[1])};
+        for (size_t x_idx{0}; x_idx < num_of_x_vars; x_idx++)
+        {
+            x[x_idx] = record[5 + x_idx];
+            gradient[x_idx] = record[5 + num_of_x_vars + x_idx];
+            next_x[x_idx] = record[5 + 2 * num_of_x_vars + x_idx];
+        }
+        store_iters << "Iteration " << static_cast<size_t>(record[0]) << ": " << '\n';
+        store_iters << "Current_x: " << x;
+        store_iters << "Gradient: " << gradient;
+        store_iters << "Norm: " << record[3] << '\n';
+        if ((flags & trace_flag_has_next) == 0)
+            continue;
+        if (algorithm_str == "newtons_method")
+        {
+            // the newton step is the full direction
+            vector<double> direction{next_x - x};
+            store_iters << "Direction: " << direction;
+        }
+        else
+            store_iters << "Step_size: " << record[4] << '\n';
+        store_iters << "Next_x: " << next_x << '\n';
+    }
+    // a partial record means the trace was cut off
+    if (trace_file.gcount() != 0)
+        throw err_invalid_trace_file();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2 and argc != 3)
+    {
+        cout << "Usage: " << argv[0] << " <trace.bin> [output.txt]" << '\n';
+        return -1;
+    }
+    string trace_filename{argv[1]};
+    string text_filename;
+    if (argc == 3)
+        text_filename = argv[2];
+    else if (trace_filename.size() > 4 and trace_filename.substr(trace_filename.size() - 4) == ".bin")
+        text_filename = trace_filename.substr(0, trace_filename.size() - 4) + ".txt";
+    else
+        text_filename = trace_filename + ".txt";
+
+    try
+    {
+        trace_to_text(trace_filename, text_filename);
+        cout << "Converted " << trace_filename << " to " << text_filename << '\n';
+    }
+    catch (const exception &e)
+    {
+        cout << e.what() << '\n';
+        return -1;
+    }
+}
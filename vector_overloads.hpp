@@ -8,9 +8,15 @@
  * @copyright Copyright (c) 2020
  * @brief A template with overloaded operators for common vector operations.
  * @details This library contains overloaded operators for a vector class. Overloaded operators for common vector operations such as addition and multiplication are defined.
+ * The arithmetic operators return lazy expression templates instead of new vectors: an expression such as x + s * d
+ * is only evaluated when it is converted to a vector, in a single loop with a single allocation,
+ * and v += s * d or v -= s * d evaluate the expression directly into v without any allocation.
+ * Note that an expression stores references to the vectors it uses, so it should be converted to a vector
+ * (not stored with auto) before those vectors go out of scope.
  */
 
 #include <iostream>
+#include <type_traits>
 #include <vector>
 
 using namespace std;
@@ -19,6 +25,196 @@ class err_size_must_match
 {
 };
 
+// ============
+// Declarations
+// ============
+
+// Base class of all vector expressions (used to recognize them)
+class vec_expr_tag
+{
+};
+
+// CRTP base class of a vector expression E with elements of type T
+// E must provide size() and operator[](size_t)
+template <typename E, typename T>
+class vec_expr : public vec_expr_tag
+{
+public:
+    using value_type = T;
+
+    // Conversion used to evaluate the expression into a new vector, in a single loop
+    operator vector<T>() const;
+};
+
+// Expression for a vector operand, stores a reference to the vector
+template <typename T>
+class vec_ref : public vec_expr<vec_ref<T>, T>
+{
+public:
+    vec_ref(const vector<T> &input_v) : v(input_v) {}
+    size_t size() const { return v.size(); }
+    T operator[](const size_t &i) const { return v[i]; }
+
+private:
+    const vector<T> &v;
+};
+
+// Expression for the elementwise sum of two vector expressions
+template <typename L, typename R>
+class vec_sum : public vec_expr<vec_sum<L, R>, typename L::value_type>
+{
+public:
+    vec_sum(const L &input_l, const R &input_r) : l(input_l), r(input_r) {}
+    size_t size() const { return l.size(); }
+    typename L::value_type operator[](const size_t &i) const { return l[i] + r[i]; }
+
+private:
+    L l;
+    R r;
+};
+
+// Expression for the elementwise difference of two vector expressions
+template <typename L, typename R>
+class vec_difference : public vec_expr<vec_difference<L, R>, typename L::value_type>
+{
+public:
+    vec_difference(const L &input_l, const R &input_r) : l(input_l), r(input_r) {}
+    size_t size() const { return l.size(); }
+    typename L::value_type operator[](const size_t &i) const { return l[i] - r[i]; }
+
+private:
+    L l;
+    R r;
+};
+
+// Expression for the negative of a vector expression
+template <typename E>
+class vec_negate : public vec_expr<vec_negate<E>, typename E::value_type>
+{
+public:
+    vec_negate(const E &input_e) : e(input_e) {}
+    size_t size() const { return e.size(); }
+    typename E::value_type operator[](const size_t &i) const { return -e[i]; }
+
+private:
+    E e;
+};
+
+// Expression for a scalar times a vector expression
+template <typename E>
+class vec_scale : public vec_expr<vec_scale<E>, typename E::value_type>
+{
+public:
+    vec_scale(const typename E::value_type &input_s, const E &input_e) : s(input_s), e(input_e) {}
+    size_t size() const { return e.size(); }
+    typename E::value_type operator[](const size_t &i) const { return s * e[i]; }
+
+private:
+    typename E::value_type s;
+    E e;
+};
+
+// Type trait used to recognize the operands of the vector operators: a vector<T> or a vector expression
+template <typename A>
+struct is_vec_operand : is_base_of<vec_expr_tag, A>
+{
+};
+
+template <typename T>
+struct is_vec_operand<vector<T>> : true_type
+{
+};
+
+// Type trait used to obtain the expression type of an operand: vec_ref<T> for a vector<T>, itself for an expression
+template <typename A>
+struct vec_expr_type
+{
+    using type = A;
+};
+
+template <typename T>
+struct vec_expr_type<vector<T>>
+{
+    using type = vec_ref<T>;
+};
+
+// Enables an operator only if all of its operands are vectors or vector expressions
+template <typename... A>
+using enable_if_vec_operands = enable_if_t<(is_vec_operand<A>::value and ...), int>;
+
+// Enables an operator only if S is a scalar and A is a vector or a vector expression
+template <typename S, typename A>
+using enable_if_scalar_vec_operands = enable_if_t<is_arithmetic<S>::value and is_vec_operand<A>::value, int>;
+
+// Overloaded binary operator << used to easily print out a vector to a stream
+template <typename T>
+ostream &operator<<(ostream &, const vector<T> &);
+
+// Overloaded binary operator + used to add two vectors, returns an expression
+template <typename A, typename B, enable_if_vec_operands<A, B> = 0>
+vec_sum<typename vec_expr_type<A>::type, typename vec_expr_type<B>::type> operator+(const A &, const B &);
+
+// Overloaded binary operator += used to add a vector to the first one in place, without allocating
+template <typename T, typename B, enable_if_vec_operands<B> = 0>
+vector<T> &operator+=(vector<T> &, const B &);
+
+// Overloaded unary operator - used to take the negative of a vector, returns an expression
+template <typename A, enable_if_vec_operands<A> = 0>
+vec_negate<typename vec_expr_type<A>::type> operator-(const A &);
+
+// Overloaded binary operator - used to subtract two vectors, returns an expression
+template <typename A, typename B, enable_if_vec_operands<A, B> = 0>
+vec_difference<typename vec_expr_type<A>::type, typename vec_expr_type<B>::type> operator-(const A &, const B &);
+
+// Overloaded binary operator -= used to subtract a vector from the first one in place, without allocating
+template <typename T, typename B, enable_if_vec_operands<B> = 0>
+vector<T> &operator-=(vector<T> &, const B &);
+
+// Overloaded binary operator * used to take the dot product of two vectors
+template <typename A, typename B, enable_if_vec_operands<A, B> = 0>
+typename vec_expr_type<A>::type::value_type operator*(const A &, const B &);
+
+// Overloaded binary operator * used to multiply a scalar on the left and a vector on the right, returns an expression
+template <typename S, typename A, enable_if_scalar_vec_operands<S, A> = 0>
+vec_scale<typename vec_expr_type<A>::type> operator*(const S &, const A &);
+
+// Overloaded binary operator * used to multiply a vector on the left and a scalar on the right, returns an expression
+template <typename S, typename A, enable_if_scalar_vec_operands<S, A> = 0>
+vec_scale<typename vec_expr_type<A>::type> operator*(const A &, const S &);
+
+// Overloaded binary operator *= used to multiply a vector by a scalar in place, without allocating
+template <typename T, typename S, enable_if_t<is_arithmetic<S>::value, int> = 0>
+vector<T> &operator*=(vector<T> &, const S &);
+
+// ==============
+// Implementation
+// ==============
+
+template <typename E, typename T>
+vec_expr<E, T>::operator vector<T>() const
+{
+    const E &e{static_cast<const E &>(*this)};
+    size_t s{e.size()};
+    vector<T> u(s);
+    for (size_t i{0}; i < s; i++)
+        u[i] = e[i];
+    return u;
+}
+
+// Function used to wrap a vector operand in an expression
+template <typename T>
+vec_ref<T> as_vec_expr(const vector<T> &v)
+{
+    return vec_ref<T>(v);
+}
+
+// Function used to pass an expression operand through unchanged
+template <typename E, typename T>
+const E &as_vec_expr(const vec_expr<E, T> &e)
+{
+    return static_cast<const E &>(e);
+}
+
 template <typename T>
 ostream &operator<<(ostream &out, const vector<T> &v)
 {
@@ -30,78 +226,86 @@ ostream &operator<<(ostream &out, const vector<T> &v)
     return out;
 }
 
-template <typename T>
-vector<T> operator+(const vector<T> &v, const vector<T> &w)
+template <typename A, typename B, enable_if_vec_operands<A, B>>
+vec_sum<typename vec_expr_type<A>::type, typename vec_expr_type<B>::type> operator+(const A &v, const B &w)
+{
+    if (v.size() != w.size())
+        throw err_size_must_match{};
+    return {as_vec_expr(v), as_vec_expr(w)};
+}
+
+template <typename T, typename B, enable_if_vec_operands<B>>
+vector<T> &operator+=(vector<T> &v, const B &w)
 {
     size_t s{v.size()};
     if (s != w.size())
         throw err_size_must_match{};
-    vector<T> u(s);
+    // each element of an expression only depends on the same element of its operands,
+    // so it is safe to evaluate it directly into v even if it uses v
+    const typename vec_expr_type<B>::type &e{as_vec_expr(w)};
     for (size_t i{0}; i < s; i++)
-        u[i] = v[i] + w[i];
-    return u;
+        v[i] += e[i];
+    return v;
 }
 
-template <typename T>
-vector<T> operator+=(vector<T> &v, const vector<T> &w)
+template <typename A, enable_if_vec_operands<A>>
+vec_negate<typename vec_expr_type<A>::type> operator-(const A &v)
 {
-    v = v + w;
-    return v;
+    return {as_vec_expr(v)};
 }
 
-template <typename T>
-vector<T> operator-(const vector<T> &v)
+template <typename A, typename B, enable_if_vec_operands<A, B>>
+vec_difference<typename vec_expr_type<A>::type, typename vec_expr_type<B>::type> operator-(const A &v, const B &w)
 {
-    size_t s{v.size()};
-    vector<T> u(s);
-    for (size_t i{0}; i < s; i++)
-        u[i] = -v[i];
-    return u;
+    if (v.size() != w.size())
+        throw err_size_must_match{};
+    return {as_vec_expr(v), as_vec_expr(w)};
 }
 
-template <typename T>
-vector<T> operator-(const vector<T> &v, const vector<T> &w)
+template <typename T, typename B, enable_if_vec_operands<B>>
+vector<T> &operator-=(vector<T> &v, const B &w)
 {
     size_t s{v.size()};
     if (s != w.size())
         throw err_size_must_match{};
-    vector<T> u(s);
+    const typename vec_expr_type<B>::type &e{as_vec_expr(w)};
     for (size_t i{0}; i < s; i++)
-        u[i] = v[i] - w[i];
-    return u;
-}
-
-template <typename T>
-vector<T> operator-=(vector<T> &v, const vector<T> &w)
-{
-    v = v - w;
+        v[i] -= e[i];
     return v;
 }
 
-template <typename T>
-T operator*(const vector<T> &v, const vector<T> &w)
+template <typename A, typename B, enable_if_vec_operands<A, B>>
+typename vec_expr_type<A>::type::value_type operator*(const A &v, const B &w)
 {
     size_t s{v.size()};
     if (s != w.size())
         throw err_size_must_match{};
-    T p{0};
+    const typename vec_expr_type<A>::type &e{as_vec_expr(v)};
+    const typename vec_expr_type<B>::type &f{as_vec_expr(w)};
+    typename vec_expr_type<A>::type::value_type p{0};
     for (size_t i{0}; i < s; i++)
-        p += v[i] * w[i];
+        p += e[i] * f[i];
     return p;
 }
 
-template <typename T>
-vector<T> operator*(const T &x, const vector<T> &v)
+template <typename S, typename A, enable_if_scalar_vec_operands<S, A>>
+vec_scale<typename vec_expr_type<A>::type> operator*(const S &x, const A &v)
 {
-    size_t s{v.size()};
-    vector<T> u(s);
-    for (size_t i{0}; i < s; i++)
-        u[i] = x * v[i];
-    return u;
+    return {static_cast<typename vec_expr_type<A>::type::value_type>(x), as_vec_expr(v)};
 }
 
-template <typename T>
-vector<T> operator*(const vector<T> &v, const T &x)
+template <typename S, typename A, enable_if_scalar_vec_operands<S, A>>
+vec_scale<typename vec_expr_type<A>::type> operator*(const A &v, const S &x)
 {
     return x * v;
-}
\ No newline at end of file
+}
+
+template <typename T, typename S, enable_if_t<is_arithmetic<S>::value, int>>
+vector<T> &operator*=(vector<T> &v, const S &x)
+{
+    size_t s{v.size()};
+    const T scale{static_cast<T>(x)};
+    for (size_t i{0}; i < s; i++)
+        v[i] *= scale;
+    return v;
+}